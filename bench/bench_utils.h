@@ -0,0 +1,156 @@
+//
+// bench_utils.h
+//
+
+#ifndef FICTION_BENCH_UTILS_H
+#define FICTION_BENCH_UTILS_H
+
+#include "logic_network.h"
+#include <boost/filesystem.hpp>
+#include <boost/range/iterator_range.hpp>
+#include <lorina/verilog.hpp>
+#include <mockturtle/io/verilog_reader.hpp>
+#include <sys/resource.h>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * Helpers shared by the benchmark executables in this folder.
+ */
+namespace bench
+{
+    /**
+     * Creates a random network of 2-input gates whose operations are drawn uniformly from the given ones. Each gate is
+     * fed by one of the last few vertices so that the network is deep enough to resemble real circuits. The network is
+     * not substituted.
+     *
+     * @param gates Number of gates.
+     * @param seed Seed of all random decisions.
+     * @param ops Operations to draw from.
+     * @param pis Number of PIs.
+     * @param pos Number of POs. They are connected to the last gates created.
+     * @return Random logic network.
+     */
+    inline logic_network_ptr random_network(const std::size_t gates, const unsigned seed,
+                                            const std::vector<operation>& ops, const std::size_t pis = 10ul,
+                                            const std::size_t pos = 5ul)
+    {
+        std::mt19937 rgen(seed);
+        auto ln = std::make_shared<logic_network>("random" + std::to_string(gates));
+
+        std::vector<logic_network::vertex> vertices{};
+        vertices.reserve(pis + gates);
+        for (std::size_t i = 0ul; i < pis; ++i)
+            vertices.push_back(ln->create_pi("x" + std::to_string(i)));
+
+        for (std::size_t i = 0ul; i < gates; ++i)
+        {
+            auto g = ln->create_logic_vertex(ops[rgen() % ops.size()]);
+            ln->create_edge(vertices[vertices.size() - 1ul - rgen() % std::min(vertices.size(), 8ul)], g);
+            ln->create_edge(vertices[rgen() % vertices.size()], g);
+            vertices.push_back(g);
+        }
+
+        for (std::size_t i = 0ul; i < std::min(pos, gates); ++i)
+            ln->create_po(vertices[vertices.size() - 1ul - i], "f" + std::to_string(i));
+
+        return ln;
+    }
+    /**
+     * Creates a random AOIG with the given number of gates. See random_network.
+     *
+     * @param gates Number of AND and OR gates.
+     * @param seed Seed of all random decisions.
+     * @param pis Number of PIs.
+     * @param pos Number of POs. They are connected to the last gates created.
+     * @return Random logic network.
+     */
+    inline logic_network_ptr random_aoig(const std::size_t gates, const unsigned seed, const std::size_t pis = 10ul,
+                                         const std::size_t pos = 5ul)
+    {
+        auto ln = random_network(gates, seed, {operation::OR, operation::AND}, pis, pos);
+        ln->substitute();
+
+        return ln;
+    }
+    /**
+     * Reads a logic network from a Verilog file in the same way the read command does.
+     *
+     * @param f Path to the Verilog file.
+     * @param substitute Flag to indicate that logic_network::substitute should be called on the parsed network.
+     * @return Parsed logic network or nullptr if parsing failed.
+     */
+    inline logic_network_ptr read_verilog(const std::string& f, const bool substitute = true)
+    {
+        auto name = boost::filesystem::path{f}.stem().string();
+        logic_network ln{std::move(name)};
+
+        if (lorina::diagnostic_engine diag{};
+            lorina::read_verilog(f, mockturtle::verilog_reader{ln}, &diag) == lorina::return_code::success)
+        {
+            if (substitute)
+                ln.substitute();
+
+            return std::make_shared<logic_network>(std::move(ln));
+        }
+
+        return nullptr;
+    }
+    /**
+     * Collects all Verilog files given directly or contained in given directories. Files of a directory are sorted
+     * by name.
+     *
+     * @param paths Paths to Verilog files or directories of those.
+     * @return Paths to all Verilog files found.
+     */
+    inline std::vector<std::string> verilog_files(const std::vector<std::string>& paths)
+    {
+        std::vector<std::string> files{};
+        for (const auto& p : paths)
+        {
+            if (boost::filesystem::is_directory(p))
+            {
+                std::vector<std::string> dir{};
+                for (auto& f : boost::make_iterator_range(boost::filesystem::directory_iterator(p), {}))
+                {
+                    if (boost::filesystem::is_regular_file(f) && boost::filesystem::extension(f) == ".v")
+                        dir.push_back(f.path().string());
+                }
+                std::sort(dir.begin(), dir.end());
+                files.insert(files.end(), dir.cbegin(), dir.cend());
+            }
+            else if (boost::filesystem::is_regular_file(p))
+                files.push_back(p);
+        }
+
+        return files;
+    }
+    /**
+     * Returns the peak resident set size of this process.
+     *
+     * @return Peak resident set size in MiB.
+     */
+    inline double peak_rss() noexcept
+    {
+        rusage usage{};
+        getrusage(RUSAGE_SELF, &usage);
+
+        return static_cast<double>(usage.ru_maxrss) / 1024.0;
+    }
+    /**
+     * Returns the seconds passed since the given point in time.
+     *
+     * @param start Point in time to measure from.
+     * @return Elapsed time in seconds.
+     */
+    inline double seconds_since(const std::chrono::steady_clock::time_point start) noexcept
+    {
+        return std::chrono::duration<double>{std::chrono::steady_clock::now() - start}.count();
+    }
+}
+
+
+#endif //FICTION_BENCH_UTILS_H
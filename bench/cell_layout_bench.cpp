@@ -0,0 +1,68 @@
+//
+// cell_layout_bench.cpp
+//
+
+#include "bench_utils.h"
+#include "orthogonal_pr.h"
+#include "fcn_cell_layout.h"
+#include "qca_one_library.h"
+#include "qca_writer.h"
+#include "svg_writer.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+
+/**
+ * Measures memory and throughput of converting gate layouts to QCA ONE cell layouts and of exporting the latter to
+ * QCADesigner files and SVG strings.
+ *
+ * Gate layouts are obtained by running orthogonal_pr on random AOIGs of the given numbers of gates, which are passed
+ * as arguments (default: 100 400 1600). For each of them, the wall clock time of the conversion and of each export
+ * path is printed together with the resulting peak resident set size and the number of assigned cells per second.
+ * Since the peak resident set size never decreases, sizes should be given in ascending order.
+ *
+ * Usage: cell_layout_bench [gates...]
+ */
+int main(int argc, char* argv[])
+{
+    std::vector<std::size_t> sizes{};
+    for (int i = 1; i < argc; ++i)
+        sizes.push_back(std::stoul(argv[i]));
+    if (sizes.empty())
+        sizes = {100ul, 400ul, 1600ul};
+
+    const auto file = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("%%%%-%%%%.qca");
+
+    std::cout << std::setw(6) << "gates" << std::setw(12) << "cells" << std::setw(12) << "convert/s"
+              << std::setw(12) << "qca/s" << std::setw(12) << "svg/s" << std::setw(14) << "cells/s conv"
+              << std::setw(12) << "peak MiB" << std::endl;
+
+    for (auto gates : sizes)
+    {
+        orthogonal_pr ortho{bench::random_aoig(gates, 0u), 4, true};
+        ortho.perform_place_and_route();
+
+        auto start = std::chrono::steady_clock::now();
+        auto fcl = std::make_shared<fcn_cell_layout>(std::make_shared<qca_one_library>(ortho.get_layout()));
+        const auto convert = bench::seconds_since(start);
+
+        start = std::chrono::steady_clock::now();
+        qca::write(fcl, file.string());
+        const auto qca = bench::seconds_since(start);
+
+        start = std::chrono::steady_clock::now();
+        const auto image = svg::generate_svg_string(fcl, true);
+        const auto svg = bench::seconds_since(start);
+
+        std::cout << std::setw(6) << gates << std::setw(12) << fcl->cell_count() << std::fixed << std::setprecision(3)
+                  << std::setw(12) << convert << std::setw(12) << qca << std::setw(12) << svg
+                  << std::setw(14) << std::setprecision(0) << static_cast<double>(fcl->cell_count()) / convert
+                  << std::setw(12) << std::setprecision(1) << bench::peak_rss() << std::endl;
+    }
+
+    boost::filesystem::remove(file);
+
+    return 0;
+}
@@ -0,0 +1,107 @@
+//
+// csr_bench.cpp
+//
+
+#include "bench_utils.h"
+#include "logic_network_csr.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+
+/**
+ * Measures the conversion of logic networks to CSR snapshots and compares traversals of both.
+ *
+ * Arguments that are numbers create random AOIGs of that many gates, all other arguments are treated as paths to
+ * Verilog files or directories of those (default: 10000 100000). For each network, the time to take a snapshot is
+ * printed together with the time of a sweep that visits the fan-out and the fan-in of every vertex, once on the
+ * logic_network and once on its snapshot. Sweeps are repeated a few times and both have to visit the same vertices.
+ *
+ * Usage: csr_bench [gates or paths...]
+ */
+namespace
+{
+    /**
+     * Number of sweeps per network.
+     */
+    constexpr const std::size_t SWEEPS = 10ul;
+    /**
+     * Takes the snapshot of the given network and compares sweeps over both. Prints the results as a table row.
+     *
+     * @param ln Logic network to benchmark.
+     */
+    void run(const logic_network& ln)
+    {
+        auto start = std::chrono::steady_clock::now();
+        const logic_network_csr csr{ln};
+        const auto convert = bench::seconds_since(start);
+
+        std::size_t ln_sum = 0ul, csr_sum = 0ul;
+
+        start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0ul; i < SWEEPS; ++i)
+        {
+            for (auto&& v : ln.vertices())
+            {
+                for (auto&& w : ln.adjacent_vertices(v))
+                    ln_sum += w;
+                for (auto&& w : ln.inv_adjacent_vertices(v))
+                    ln_sum += w;
+            }
+        }
+        const auto ln_sweep = bench::seconds_since(start);
+
+        start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0ul; i < SWEEPS; ++i)
+        {
+            for (auto&& v : csr.vertices())
+            {
+                for (auto&& w : csr.fan_out(v))
+                    csr_sum += w;
+                for (auto&& w : csr.fan_in(v))
+                    csr_sum += w;
+            }
+        }
+        const auto csr_sweep = bench::seconds_since(start);
+
+        std::cout << std::left << std::setw(16) << ln.get_name() << std::right << std::setw(10) << csr.vertex_count()
+                  << std::setw(10) << csr.edge_count() << std::fixed << std::setprecision(4) << std::setw(12)
+                  << convert << std::setw(12) << ln_sweep << std::setw(12) << csr_sweep << std::setw(10)
+                  << std::setprecision(1) << ln_sweep / csr_sweep << (ln_sum == csr_sum ? "" : "  MISMATCH")
+                  << std::endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::size_t> sizes{};
+    std::vector<std::string> paths{};
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg{argv[i]};
+        if (arg.find_first_not_of("0123456789") == std::string::npos)
+            sizes.push_back(std::stoul(arg));
+        else
+            paths.push_back(arg);
+    }
+    if (sizes.empty() && paths.empty())
+        sizes = {10000ul, 100000ul};
+
+    std::cout << std::left << std::setw(16) << "network" << std::right << std::setw(10) << "vertices" << std::setw(10)
+              << "edges" << std::setw(12) << "convert/s" << std::setw(12) << "sweep ln/s" << std::setw(12)
+              << "sweep csr/s" << std::setw(10) << "speed-up" << std::endl;
+
+    for (auto gates : sizes)
+        run(*bench::random_aoig(gates, 0u));
+
+    for (const auto& f : bench::verilog_files(paths))
+    {
+        if (auto ln = bench::read_verilog(f); ln)
+            run(*ln);
+        else
+            std::cerr << "[e] parsing error in " << f << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,63 @@
+//
+// ortho_scaling_bench.cpp
+//
+
+#include "bench_utils.h"
+#include "orthogonal_pr.h"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+/**
+ * Measures how orthogonal_pr scales with the size and depth of the network.
+ *
+ * Random AOIGs of the given numbers of gates are placed and routed (default: 1000 2000 4000). Since each gate is fed by
+ * one of the most recently created vertices, the logic depth grows linearly with the number of gates, which stresses
+ * the joint DFS and the red-blue coloring the same way deep circuits like EPFL's div and log2 do. The time to generate
+ * the network, the P&R runtime, the layout's dimensions, and the resulting peak resident set size are printed. Since
+ * the peak resident set size never decreases, sizes should be given in ascending order.
+ *
+ * Both extents of orthogonal layouts grow linearly with the number of vertices. Hence, their area and thereby memory
+ * consumption grow quadratically, e.g. 4000 gates already need about 2 GiB.
+ *
+ * Usage: ortho_scaling_bench [gates...]
+ */
+int main(int argc, char* argv[])
+{
+    std::vector<std::size_t> sizes{};
+    for (int i = 1; i < argc; ++i)
+        sizes.push_back(std::stoul(argv[i]));
+    if (sizes.empty())
+        sizes = {1000ul, 2000ul, 4000ul};
+
+    std::cout << std::setw(9) << "gates" << std::setw(10) << "vertices" << std::setw(12) << "generate/s"
+              << std::setw(12) << "ortho/s" << std::setw(18) << "layout" << std::setw(12) << "peak MiB" << std::endl;
+
+    for (auto gates : sizes)
+    {
+        auto start = std::chrono::steady_clock::now();
+        auto ln = bench::random_aoig(gates, 0u);
+        const auto generate = bench::seconds_since(start);
+        const auto vertices = ln->vertex_count();
+
+        start = std::chrono::steady_clock::now();
+        orthogonal_pr ortho{std::move(ln), 4, true};
+        const auto result = ortho.perform_place_and_route();
+        const auto pr = bench::seconds_since(start);
+
+        std::stringstream dim{};
+        if (result.success)
+            dim << ortho.get_layout()->x() << "x" << ortho.get_layout()->y();
+        else
+            dim << "-";
+
+        std::cout << std::setw(9) << gates << std::setw(10) << vertices << std::fixed << std::setprecision(3)
+                  << std::setw(12) << generate << std::setw(12) << pr << std::setw(18) << dim.str() << std::setw(12)
+                  << std::setprecision(1) << bench::peak_rss() << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,98 @@
+//
+// substitute_bench.cpp
+//
+
+#include "bench_utils.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+
+/**
+ * Measures logic_network::substitute, which decomposes XORs and inserts fan-outs, on Verilog benchmarks and random
+ * networks.
+ *
+ * Arguments that are numbers create random networks of that many AND, OR, and XOR gates in equal shares, all other
+ * arguments are treated as paths to Verilog files or directories of those (default: ../benchmarks/EPFL 100000). Files
+ * are parsed without substitution first, which is timed separately. For each network, the number of XOR vertices and
+ * the number of vertices before and after substitution are printed as well.
+ *
+ * Usage: substitute_bench [gates or paths...]
+ */
+namespace
+{
+    /**
+     * Substitutes the given network and prints the results as a table row.
+     *
+     * @param ln Logic network to substitute.
+     * @param parse Time spent on parsing the network in seconds.
+     * @return Time spent on substitution in seconds.
+     */
+    double run(logic_network& ln, const double parse)
+    {
+        const auto xors = ln.operation_count(operation::XOR);
+        const auto before = ln.vertex_count(true, true);
+
+        const auto start = std::chrono::steady_clock::now();
+        ln.substitute();
+        const auto substitute = bench::seconds_since(start);
+
+        std::cout << std::left << std::setw(16) << ln.get_name() << std::right << std::setw(10) << xors
+                  << std::setw(10) << before << std::setw(10) << ln.vertex_count(true, true) << std::fixed
+                  << std::setprecision(3) << std::setw(12) << parse << std::setw(14) << substitute << std::endl;
+
+        return substitute;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::size_t> sizes{};
+    std::vector<std::string> paths{};
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg{argv[i]};
+        if (arg.find_first_not_of("0123456789") == std::string::npos)
+            sizes.push_back(std::stoul(arg));
+        else
+            paths.push_back(arg);
+    }
+    if (sizes.empty() && paths.empty())
+    {
+        paths.emplace_back("../benchmarks/EPFL");
+        sizes.push_back(100000ul);
+    }
+
+    std::cout << std::left << std::setw(16) << "circuit" << std::right << std::setw(10) << "XORs" << std::setw(10)
+              << "vertices" << std::setw(10) << "subst." << std::setw(12) << "parse/s" << std::setw(14)
+              << "substitute/s" << std::endl;
+
+    double total_parse = 0.0, total_substitute = 0.0;
+    for (const auto& f : bench::verilog_files(paths))
+    {
+        const auto start = std::chrono::steady_clock::now();
+        auto ln = bench::read_verilog(f, false);
+        const auto parse = bench::seconds_since(start);
+
+        if (!ln)
+        {
+            std::cerr << "[e] parsing error in " << f << std::endl;
+            continue;
+        }
+
+        total_parse += parse;
+        total_substitute += run(*ln, parse);
+    }
+
+    for (auto gates : sizes)
+    {
+        auto ln = bench::random_network(gates, 0u, {operation::AND, operation::OR, operation::XOR});
+        total_substitute += run(*ln, 0.0);
+    }
+
+    std::cout << "total parsing time: " << std::fixed << std::setprecision(3) << total_parse
+              << " s, total substitution time: " << total_substitute << " s" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,137 @@
+//
+// symmetry_breaking_bench.cpp
+//
+
+#include "bench_utils.h"
+#include "exact_pr.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+
+/**
+ * Compares exact_pr with and without symmetry breaking on Verilog benchmarks.
+ *
+ * Each given Verilog file, or each one in a given directory, is placed and routed twice with the same configuration,
+ * once with symmetry_breaking disabled and once with it enabled. For both runs, the area of the resulting layout, the
+ * runtime in seconds, and whether the layout was proven minimal are printed. Circuits that cannot be placed and routed
+ * with the selected scheme or within the timeout are marked with '-'.
+ *
+ * Usage: symmetry_breaking_bench [-s <clocking scheme>] [-t <timeout in s>] [paths...]
+ *
+ * The default scheme is USE, the default timeout is 300 s, and the default path is ../benchmarks/TOY.
+ */
+namespace
+{
+    /**
+     * Outcome of a single exact_pr run.
+     */
+    struct run_result
+    {
+        bool success = false;
+        std::size_t area = 0ul;
+        double runtime = 0.0;
+        bool optimal = false;
+    };
+    /**
+     * Places and routes the given network exactly.
+     *
+     * @param ln Logic network to place and route.
+     * @param scheme Clocking scheme to use.
+     * @param timeout Timeout in ms.
+     * @param symmetry_breaking Flag to indicate that symmetry breaking should be used.
+     * @return Outcome of the run.
+     */
+    run_result run(logic_network_ptr ln, const fcn_clocking_scheme& scheme, const unsigned timeout,
+                   const bool symmetry_breaking)
+    {
+        exact_pr_config config{};
+        config.scheme = std::make_shared<fcn_clocking_scheme>(scheme);
+        config.timeout = timeout;
+        config.symmetry_breaking = symmetry_breaking;
+
+        const auto start = std::chrono::steady_clock::now();
+        exact_pr pr{std::move(ln), std::move(config)};
+        auto result = pr.perform_place_and_route();
+        const auto runtime = bench::seconds_since(start);
+
+        if (!result.success)
+            return run_result{false, 0ul, runtime, false};
+
+        auto fgl = pr.get_layout();
+        return run_result{true, fgl->x() * fgl->y(), runtime, result.json["optimal"].get<bool>()};
+    }
+    /**
+     * Prints the outcome of a single run as three columns.
+     *
+     * @param r Outcome to print.
+     */
+    void print(const run_result& r)
+    {
+        if (r.success)
+            std::cout << std::setw(8) << r.area;
+        else
+            std::cout << std::setw(8) << "-";
+
+        std::cout << std::setw(10) << std::fixed << std::setprecision(2) << r.runtime << std::setw(5)
+                  << (r.optimal ? "yes" : "no");
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    std::string clocking{"USE"};
+    unsigned timeout = 300u;
+    std::vector<std::string> paths{};
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg{argv[i]};
+        if (arg == "-s" && i + 1 < argc)
+            clocking = argv[++i];
+        else if (arg == "-t" && i + 1 < argc)
+            timeout = static_cast<unsigned>(std::stoul(argv[++i]));
+        else
+            paths.push_back(arg);
+    }
+    if (paths.empty())
+        paths.emplace_back("../benchmarks/TOY");
+
+    const auto scheme = get_clocking_scheme(clocking);
+    if (!scheme)
+    {
+        std::cerr << "[e] \"" << clocking << "\" does not refer to a supported clocking scheme" << std::endl;
+        return 1;
+    }
+
+    std::cout << std::left << std::setw(16) << "circuit" << std::right << std::setw(8) << "area" << std::setw(10)
+              << "time/s" << std::setw(5) << "opt" << std::setw(8) << "area SB" << std::setw(10) << "time/s SB"
+              << std::setw(5) << "opt" << std::endl;
+
+    double total_off = 0.0, total_on = 0.0;
+    for (const auto& f : bench::verilog_files(paths))
+    {
+        auto ln = bench::read_verilog(f);
+        if (!ln)
+        {
+            std::cerr << "[e] parsing error in " << f << std::endl;
+            continue;
+        }
+
+        // each run works on its own copy because exact_pr may alter the network
+        const auto off = run(std::make_shared<logic_network>(*ln), *scheme, timeout * 1000u, false);
+        const auto on  = run(std::make_shared<logic_network>(*ln), *scheme, timeout * 1000u, true);
+        total_off += off.runtime;
+        total_on  += on.runtime;
+
+        std::cout << std::left << std::setw(16) << ln->get_name() << std::right;
+        print(off);
+        print(on);
+        std::cout << std::endl;
+    }
+
+    std::cout << "total runtime without symmetry breaking: " << std::fixed << std::setprecision(2) << total_off
+              << " s, with symmetry breaking: " << total_on << " s" << std::endl;
+
+    return 0;
+}
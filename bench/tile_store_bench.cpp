@@ -0,0 +1,75 @@
+//
+// tile_store_bench.cpp
+//
+
+#include "bench_utils.h"
+#include "orthogonal_pr.h"
+#include "design_checker.h"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+/**
+ * Measures the hot accessors of fcn_gate_layout's tile store on large orthogonal layouts.
+ *
+ * Gate layouts are obtained by running orthogonal_pr on random AOIGs of the given numbers of gates, which are passed
+ * as arguments (default: 500, which yields a layout of about 750 x 350, i.e. as many tiles as 500 x 500). For each of
+ * them, the time needed to look up the logic vertex and the logic edges of every tile, a full design_checker::check,
+ * and the first, i.e. uncached, call of critical_path_length_and_throughput are printed in seconds.
+ *
+ * Usage: tile_store_bench [gates...]
+ */
+int main(int argc, char* argv[])
+{
+    std::vector<std::size_t> sizes{};
+    for (int i = 1; i < argc; ++i)
+        sizes.push_back(std::stoul(argv[i]));
+    if (sizes.empty())
+        sizes = {500ul};
+
+    std::cout << std::setw(6) << "gates" << std::setw(12) << "layout" << std::setw(12) << "lookups/s" << std::setw(12)
+              << "check/s" << std::setw(12) << "cp+tp/s" << std::setw(12) << "peak MiB" << std::endl;
+
+    for (auto gates : sizes)
+    {
+        orthogonal_pr ortho{bench::random_aoig(gates, 0u), 4, true};
+        ortho.perform_place_and_route();
+        auto fgl = ortho.get_layout();
+
+        // query every tile of the layout, most of which are empty
+        auto start = std::chrono::steady_clock::now();
+        std::size_t occupied = 0ul;
+        for (auto&& t : fgl->tiles())
+        {
+            if (fgl->get_logic_vertex(t))
+                ++occupied;
+            occupied += fgl->get_logic_edges(t).size();
+        }
+        const auto lookups = bench::seconds_since(start);
+
+        start = std::chrono::steady_clock::now();
+        {
+            std::stringstream ss{};
+            design_checker checker{fgl};
+            checker.check(ss, true);
+        }
+        const auto check = bench::seconds_since(start);
+
+        start = std::chrono::steady_clock::now();
+        const auto cp_tp = fgl->critical_path_length_and_throughput();
+        const auto timing = bench::seconds_since(start);
+
+        std::stringstream dim{};
+        dim << fgl->x() << "x" << fgl->y();
+
+        std::cout << std::setw(6) << gates << std::setw(12) << dim.str() << std::fixed << std::setprecision(3)
+                  << std::setw(12) << lookups << std::setw(12) << check << std::setw(12) << timing << std::setw(12)
+                  << std::setprecision(1) << bench::peak_rss() << "  (" << occupied << " elements, critical path "
+                  << cp_tp.first << ")" << std::endl;
+    }
+
+    return 0;
+}
@@ -4,224 +4,313 @@
 
 #include "design_checker.h"
 
-design_checker::design_checker(fcn_gate_layout_ptr fgl, std::size_t wl)
+design_checker::design_checker(fcn_gate_layout_ptr fgl, std::size_t wl, unsigned threads, const bool incremental)
         :
         layout{std::move(fgl)},
-        wire_limit{wl}
-{}
+        wire_limit{wl},
+        threads{threads}
+{
+    if (incremental)
+        observer_id = layout->register_tile_observer([this](const fcn_gate_layout::tile& _t)
+                                                     {dirty.push_back(fcn_gate_layout::tile{_t[X], _t[Y], GROUND});});
+}
 
-nlohmann::json design_checker::check(std::ostream& out) noexcept
+design_checker::~design_checker()
 {
-    nlohmann::json report{};
+    if (observer_id)
+        layout->unregister_tile_observer(*observer_id);
+}
 
-    out << "Topology:" << std::endl;
-    out << wire_count_check(report) << std::endl;
-    out << missing_connections_check(report) << std::endl;
-    out << crossing_gates_check(report) << std::endl;
-    out << std::endl;
+nlohmann::json design_checker::check(std::ostream& out, const bool quiet) noexcept
+{
+    auto rules = create_rules();
 
-    out << "Clocking:" << std::endl;
-    out << tile_clocking_check(report) << std::endl;
-    out << direction_check(report) << std::endl;
-    out << std::endl;
+    // changes that do not notify tile observers invalidate all cached violations
+    if (cache && cache->x == layout->x() && cache->y == layout->y() && cache->z == layout->z() &&
+        cache->regular == layout->is_regularly_clocked())
+        revise(rules);
+    else
+        inspect(rules);
 
-    out << "I/O ports:" << std::endl;
-    out << operation_io_check(report) << std::endl;
-    out << io_port_check(report) << std::endl;
-    out << border_io_check(report) << std::endl;
+    if (observer_id)
+    {
+        dirty.clear();
 
-    return report;
-}
+        cache = check_cache{{}, layout->x(), layout->y(), layout->z(), layout->is_regularly_clocked()};
+        for (const auto& r : rules)
+            cache->violations.push_back(r.violations);
+    }
 
-void design_checker::log_tile(const fcn_gate_layout::tile& t, nlohmann::json& report) const noexcept
-{
-    std::stringstream s{};
+    nlohmann::json report{};
+    for (auto& r : rules)
+        report[r.key] = std::move(r.violations);
 
-    if (auto v = layout->get_logic_vertex(t))
-        s << "v: " << *v;  // log vertex
-    else if (layout->is_wire_tile(t))
+    if (!quiet)
     {
-        s << "e: { ";
-        for (const auto& e : layout->get_logic_edges(t))
-            s << e << " ";  // log edges
-        s << "}";
-    }
-    else  // empty tile
-        s << "empty";
+        const char* section = nullptr;
+        for (auto& r : rules)
+        {
+            if (section != r.section)
+            {
+                if (section)
+                    out << std::endl;
 
-    auto clk = layout->tile_clocking(t);
-    auto l   = layout->get_latch(t);
-    s << fmt::format(", clk: {}{}, inp: {}, out: {}{}{}", (clk ? std::to_string(*clk) : ""),
-                     (l ? ", l: " + std::to_string(l) : ""),
-                     layout->get_tile_inp_dirs(t), layout->get_tile_out_dirs(t), (layout->is_pi(t) ? ", PI" : ""),
-                     (layout->is_po(t) ? ", PO" : ""));
+                section = r.section;
+                out << section << std::endl;
+            }
 
-    report[to_string(t)] = s.str();
-}
+            out << summary(std::move(r.msg), r.passed, r.breaking) << std::endl;
+        }
+    }
 
-std::string design_checker::summary(std::string&& msg, const bool chk, const bool brk) const noexcept
-{
-    return fmt::format(" {} {}" + std::move(msg), chk ? CHECK_PASSED : (brk ? CHECK_FAILED : WARNING), chk ? "" : "not ");
+    return report;
 }
 
-std::string design_checker::wire_count_check(nlohmann::json& report) const noexcept
+std::vector<design_checker::design_rule> design_checker::create_rules() const noexcept
 {
-    nlohmann::json wire_report{};
+    static constexpr const char* TOPOLOGY = "Topology:", * CLOCKING = "Clocking:", * IO_PORTS = "I/O ports:";
 
-    auto all_matched = std::none_of(layout->e_map.begin(), layout->e_map.end(),
-            [this](const auto& _w){return _w.second.size() > wire_limit;});
+    std::vector<design_rule> rules{};
 
-    report["Overfull tiles"] = wire_report;
+    rules.push_back({TOPOLOGY, "Overfull tiles",
+                     fmt::format("all tiles have at most {} wire{} assigned", wire_limit, wire_limit != 1 ? "s" : ""),
+                     true, [this](const tile_context& _ctx){return _ctx.td.wires.size() > wire_limit;}});
 
-    return summary(fmt::format("all tiles have at most {} wire{} assigned", wire_limit, wire_limit != 1 ? "s" : ""), all_matched, true);
-}
+    rules.push_back({TOPOLOGY, "Missing connections", "all occupied tiles are properly connected", true,
+                     [this](const tile_context& _ctx)
+                     {
+                         return (_ctx.out.empty() && !layout->is_po(_ctx.t)) ||
+                                (_ctx.inp.empty() && !layout->is_pi(_ctx.t));
+                     }});
 
-std::string design_checker::missing_connections_check(nlohmann::json& report) const noexcept
-{
-    nlohmann::json connections_report{};
+    rules.push_back({TOPOLOGY, "Wires crossing gates", "all wire crossings cross over other wires only", true,
+                     [this](const tile_context& _ctx)
+                     {
+                         return _ctx.t[Z] != GROUND && !layout->is_wire_tile(layout->below(_ctx.t));
+                     }});
 
-    auto all_connected = true;
-    for (auto&& t : layout->tiles() | iter::filterfalse([this](const auto& _t){return layout->is_free_tile(_t);}))
-    {
-        auto odf = layout->outgoing_data_flow(t);
-        bool dangling_out_connection = (std::distance(odf.begin(), odf.end()) == 0) && !layout->is_po(t);
+    // regularly clocked layouts assign a clock zone to every tile
+    rules.push_back({CLOCKING, "Unclocked non-empty tiles", "all occupied tiles are clocked", false,
+                     layout->is_regularly_clocked() ? std::function<bool(const tile_context&)>{} :
+                     [this](const tile_context& _ctx){return !layout->tile_clocking(_ctx.t);}});
 
-        auto idf = layout->incoming_data_flow(t);
-        bool dangling_inp_connection = (std::distance(idf.begin(), idf.end()) == 0) && !layout->is_pi(t);
+    rules.push_back({CLOCKING, "Directions against data flow", "all tiles' directions respect data flow", true,
+                     [this](const tile_context& _ctx)
+                     {
+                         layout::directions out_dirs{}, inp_dirs{};
 
-        if (dangling_out_connection || dangling_inp_connection)
-        {
-            all_connected = false;
-            log_tile(t, connections_report);
-        }
-    }
+                         for (auto&& odf : _ctx.out)
+                             out_dirs |= layout->get_bearing(_ctx.t, odf);
+
+                         for (auto&& idf : _ctx.inp)
+                             inp_dirs |= layout->get_bearing(_ctx.t, idf);
+
+                         return out_dirs != layout::directions{_ctx.td.out_dirs} ||
+                                inp_dirs != layout::directions{_ctx.td.inp_dirs};  // TODO log directions as well
+                     }});
 
-    report["Missing connections"] = connections_report;
+    rules.push_back({IO_PORTS, "Wire I/O ports", "all I/O ports are assigned to some operation", true, {},
+                     [this](const fcn_gate_layout::tile& _io){return !layout->is_gate_tile(_io);}});
 
-    return summary("all occupied tiles are properly connected", all_connected, true);
+    rules.push_back({IO_PORTS, "Gate I/O ports", "all I/O ports are realized by designated pins", false, {},
+                     [this](const fcn_gate_layout::tile& _io)
+                     {
+                         const auto op = layout->get_op(_io);
+                         return op != operation::PI && op != operation::PO;
+                     }});
+
+    rules.push_back({IO_PORTS, "Border I/O ports", "all I/O ports are located at layout's borders", false, {},
+                     [this](const fcn_gate_layout::tile& _io){return !layout->is_border_tile(_io);}});
+
+    return rules;
 }
 
-std::string design_checker::crossing_gates_check(nlohmann::json& report) const noexcept
+void design_checker::inspect(std::vector<design_rule>& rules) const noexcept
 {
-    nlohmann::json crossing_report{};
+    const auto num_threads = threads ? threads : std::max(std::thread::hardware_concurrency(), 1u);
+
+    // more bands than threads balance the load of unevenly occupied rows
+    const auto num_rows  = std::max(layout->y(), std::size_t{1ul});
+    const auto num_bands = std::min(num_threads == 1u ? 1ul : num_threads * 4ul, num_rows);
 
-    auto all_wire_crossings = true;
-    for (auto&& cross : layout->crossing_layers() | iter::filterfalse([this](const auto& _t){return layout->is_free_tile(_t);}))
+    // occupied tiles are stored in the layout's tile storage such that other positions do not need to be visited
+    std::vector<std::vector<std::size_t>> bands(num_bands);
+    for (std::size_t p = 0ul; p < layout->tile_store.size(); ++p)
     {
-        if (!layout->is_wire_tile(layout->below(cross)))
-        {
-            all_wire_crossings = false;
-            log_tile(cross, crossing_report);
-        }
+        const auto t = layout->stored_tile(p);
+        if (t[X] >= layout->x() || t[Y] >= layout->y() || t[Z] >= layout->z())
+            continue;
+
+        if (const auto& td = layout->tile_store[p]; td.vertex || !td.wires.empty())
+            bands[t[Y] * num_bands / num_rows].push_back(p);
     }
 
-    report["Wires crossing gates"] = crossing_report;
+    std::vector<std::vector<nlohmann::json>> band_violations(num_bands, std::vector<nlohmann::json>(rules.size()));
+    std::atomic<std::size_t> next{0ul};
 
-    return summary("all wire crossings cross over other wires only", all_wire_crossings, true);
-}
+    const auto check_bands = [&]()
+    {
+        for (std::size_t b; (b = next++) < num_bands;)
+        {
+            for (auto p : bands[b])
+                inspect_tile(rules, p, band_violations[b]);
+        }
+    };
 
-std::string design_checker::tile_clocking_check(nlohmann::json& report) const noexcept
-{
-    nlohmann::json clock_report{};
+    if (num_bands == 1ul)
+        check_bands();
+    else
+    {
+        std::vector<std::thread> workers{};
+        for (unsigned i = 0u, n = static_cast<unsigned>(std::min(std::size_t{num_threads}, num_bands)); i < n; ++i)
+            workers.emplace_back(check_bands);
+        for (auto& w : workers)
+            w.join();
+    }
 
-    auto all_clocked = true;
-    if (!layout->is_regularly_clocked())
+    // merge in band order
+    for (auto& bv : band_violations)
     {
-        for (auto&& t : layout->tiles() | iter::filterfalse([this](const auto& _t){return layout->is_free_tile(_t);}))
+        for (std::size_t r = 0ul; r < rules.size(); ++r)
         {
-            if (!layout->tile_clocking(t))
-            {
-                all_clocked = false;
-                log_tile(t, clock_report);
-            }
+            if (bv[r].is_null())
+                continue;
+
+            rules[r].passed = false;
+            rules[r].violations.update(bv[r]);
         }
     }
 
-    report["Unclocked non-empty tiles"] = clock_report;
-
-    return summary("all occupied tiles are clocked", all_clocked, false);
+    inspect_io(rules);
 }
 
-std::string design_checker::direction_check(nlohmann::json& report) const noexcept
+void design_checker::revise(std::vector<design_rule>& rules) noexcept
 {
-    nlohmann::json direction_report{};
+    for (std::size_t r = 0ul; r < rules.size(); ++r)
+        rules[r].violations = std::move(cache->violations[r]);
 
-    auto correct_directions = true;
-    for (auto&& t : layout->tiles() | iter::filterfalse([this](const auto& _t){return layout->is_free_tile(_t);}))
-    {
-        layout::directions out_dirs{}, inp_dirs{};
+    std::sort(dirty.begin(), dirty.end());
+    dirty.erase(std::unique(dirty.begin(), dirty.end()), dirty.end());
 
-        for (auto&& odf : layout->outgoing_data_flow(t))
-            out_dirs |= layout->get_bearing(t, odf);
-
-        for (auto&& idf : layout->incoming_data_flow(t))
-            inp_dirs |= layout->get_bearing(t, idf);
+    // data flow of a tile only depends on the tile's stack and its adjacent stacks
+    std::vector<fcn_gate_layout::tile> region{};
+    for (const auto& d : dirty)
+    {
+        if (d[X] >= layout->x() || d[Y] >= layout->y())
+            continue;
 
-        if ((out_dirs != layout->get_tile_out_dirs(t)) || (inp_dirs != layout->get_tile_inp_dirs(t)))
+        for (std::size_t z = 0ul; z < layout->z(); ++z)
         {
-            correct_directions = false;
-            log_tile(t, direction_report);  // TODO log directions as well
+            region.push_back(fcn_gate_layout::tile{d[X], d[Y], z});
+            if (d[X] > 0ul)
+                region.push_back(fcn_gate_layout::tile{d[X] - 1, d[Y], z});
+            if (d[X] + 1 < layout->x())
+                region.push_back(fcn_gate_layout::tile{d[X] + 1, d[Y], z});
+            if (d[Y] > 0ul)
+                region.push_back(fcn_gate_layout::tile{d[X], d[Y] - 1, z});
+            if (d[Y] + 1 < layout->y())
+                region.push_back(fcn_gate_layout::tile{d[X], d[Y] + 1, z});
         }
     }
 
-    report["Directions against data flow"] = direction_report;
-
-    return summary("all tiles' directions respect data flow", correct_directions, true);
-}
+    std::sort(region.begin(), region.end());
+    region.erase(std::unique(region.begin(), region.end()), region.end());
 
-std::string design_checker::operation_io_check(nlohmann::json& report) const noexcept
-{
-    nlohmann::json wire_io_report{};
-
-    auto all_operation = true;
-    for (auto&& io : iter::chain(layout->get_pis(), layout->get_pos()))
+    // forget previous violations of the region and re-inspect its occupied tiles
+    std::vector<nlohmann::json> revised(rules.size());
+    for (const auto& t : region)
     {
-        if (!layout->is_gate_tile(io))
+        const auto key = to_string(t);
+        for (auto& r : rules)
         {
-            all_operation = false;
-            log_tile(io, wire_io_report);
+            if (r.tile_violated && r.violations.is_object())
+                r.violations.erase(key);
         }
+
+        if (auto p = layout->store_position(t); p && *p < layout->tile_store.size())
+        {
+            if (const auto& td = layout->tile_store[*p]; td.vertex || !td.wires.empty())
+                inspect_tile(rules, *p, revised);
+        }
+    }
+
+    for (std::size_t r = 0ul; r < rules.size(); ++r)
+    {
+        if (!revised[r].is_null())
+            rules[r].violations.update(revised[r]);
+
+        // PI/POs are few and changes might have moved them anywhere
+        if (rules[r].io_violated)
+            rules[r].violations = nullptr;
     }
 
-    report["Wire I/O ports"] = wire_io_report;
+    inspect_io(rules);
 
-    return summary("all I/O ports are assigned to some operation", all_operation, true);
+    // rules without any violations are reported the same way a full check does
+    for (auto& r : rules)
+    {
+        if (r.violations.empty())
+            r.violations = nullptr;
+
+        r.passed = r.violations.is_null();
+    }
 }
 
-std::string design_checker::io_port_check(nlohmann::json& report) const noexcept
+void design_checker::inspect_io(std::vector<design_rule>& rules) const noexcept
 {
-    nlohmann::json port_report{};
-
-    auto all_pin = true;
     for (auto&& io : iter::chain(layout->get_pis(), layout->get_pos()))
     {
-        if (layout->get_op(io) != operation::PI && layout->get_op(io) != operation::PO)
+        for (auto& r : rules)
         {
-            all_pin = false;
-            log_tile(io, port_report);
+            if (r.io_violated && r.io_violated(io))
+            {
+                r.passed = false;
+                log_tile(io, r.violations);
+            }
         }
     }
+}
 
-    report["Gate I/O ports"] = port_report;
+void design_checker::inspect_tile(const std::vector<design_rule>& rules, const std::size_t p,
+                                  std::vector<nlohmann::json>& violations) const noexcept
+{
+    const auto t = layout->stored_tile(p);
+    const tile_context ctx{t, layout->tile_store[p], layout->incoming_data_flow(t), layout->outgoing_data_flow(t)};
 
-    return summary("all I/O ports are realized by designated pins", all_pin, false);
+    for (std::size_t r = 0ul; r < rules.size(); ++r)
+    {
+        if (rules[r].tile_violated && rules[r].tile_violated(ctx))
+            log_tile(t, violations[r]);
+    }
 }
 
-std::string design_checker::border_io_check(nlohmann::json& report) const noexcept
+void design_checker::log_tile(const fcn_gate_layout::tile& t, nlohmann::json& report) const noexcept
 {
-    nlohmann::json border_report{};
+    std::stringstream s{};
 
-    auto all_border = true;
-    for (auto&& io : iter::chain(layout->get_pis(), layout->get_pos()))
+    if (auto v = layout->get_logic_vertex(t))
+        s << "v: " << *v;  // log vertex
+    else if (layout->is_wire_tile(t))
     {
-        if (!layout->is_border_tile(io))
-        {
-            all_border = false;
-            log_tile(io, border_report);
-        }
+        s << "e: { ";
+        for (const auto& e : layout->get_logic_edges(t))
+            s << e << " ";  // log edges
+        s << "}";
     }
+    else  // empty tile
+        s << "empty";
+
+    auto clk = layout->tile_clocking(t);
+    auto l   = layout->get_latch(t);
+    s << fmt::format(", clk: {}{}, inp: {}, out: {}{}{}", (clk ? std::to_string(*clk) : ""),
+                     (l ? ", l: " + std::to_string(l) : ""),
+                     layout->get_tile_inp_dirs(t), layout->get_tile_out_dirs(t), (layout->is_pi(t) ? ", PI" : ""),
+                     (layout->is_po(t) ? ", PO" : ""));
 
-    report["Border I/O ports"] = border_report;
+    report[to_string(t)] = s.str();
+}
 
-    return summary("all I/O ports are located at layout's borders", all_border, false);
+std::string design_checker::summary(std::string&& msg, const bool chk, const bool brk) const noexcept
+{
+    return fmt::format(" {} {}" + std::move(msg), chk ? CHECK_PASSED : (brk ? CHECK_FAILED : WARNING), chk ? "" : "not ");
 }
@@ -13,6 +13,12 @@
 #include <ostream>
 #include <string>
 #include <sstream>
+#include <vector>
+#include <optional>
+#include <algorithm>
+#include <functional>
+#include <thread>
+#include <atomic>
 
 
 class design_checker
@@ -23,12 +29,14 @@ public:
      *
      * @param fgl Gate layout to check for design rule flaws.
      * @param wl Maximum number of wires per tile.
+     * @param threads Number of threads to check row bands of the layout with (0 uses all available).
+     * @param incremental Flag to indicate that the checker should observe fgl and only re-check changed tiles.
      */
-    design_checker(fcn_gate_layout_ptr fgl, std::size_t wl = 1);
+    design_checker(fcn_gate_layout_ptr fgl, std::size_t wl = 1, unsigned threads = 1u, const bool incremental = false);
     /**
-     * Default Destructor.
+     * Destructor. Unregisters the checker from its layout if it is incremental.
      */
-    ~design_checker() = default;
+    ~design_checker();
     /**
      * Copy constructor is not available.
      */
@@ -60,9 +68,26 @@ public:
      *   - Not all PO/PIs located at layout's borders
      *   - Gate I/Os instead of designated PI/PO ports
      *
+     * All rules inspect each occupied tile during a single traversal of the layout's tile storage. Information that
+     * several rules need, like a tile's data flow, is determined only once per tile. PI/POs are inspected afterwards.
+     *
+     * For multiple threads, the layout is split into bands of consecutive rows that are inspected concurrently. Since
+     * rules read neighboring tiles directly from the layout, tiles at band borders see their neighbors in adjacent bands
+     * without any halo exchange. Violations are buffered per band and merged in band order afterwards such that the
+     * report does not depend on the number of threads.
+     *
+     * An incremental checker registers itself as a tile observer of its layout and keeps track of changed tiles. Its
+     * first call performs a full check whose violations are cached. Subsequent calls only re-inspect changed tiles and
+     * their adjacent stacks, which are the only ones whose data flow can be affected by a change, and update the cached
+     * violations accordingly. The resulting report is identical to the one of a full check. Since fcn_layout::resize
+     * does not notify tile observers, a change of the layout's dimensions or of its clocking's regularity leads to a
+     * full check again.
+     *
+     * @param out Stream to print a summary of all checks to.
+     * @param quiet Flag to indicate that no summary should be formatted and printed, i.e. only the report is generated.
      * @return A detailed report containing all check results.
      */
-    nlohmann::json check(std::ostream& out = std::cout) noexcept;
+    nlohmann::json check(std::ostream& out = std::cout, const bool quiet = false) noexcept;
 
 private:
     /**
@@ -73,6 +98,40 @@ private:
      * Maximum number of logic edges allowed per tile.
      */
     const std::size_t wire_limit;
+    /**
+     * Number of threads to check with.
+     */
+    const unsigned threads;
+    /**
+     * Identifier of the checker as a tile observer of layout if it is incremental.
+     */
+    std::optional<std::size_t> observer_id{};
+    /**
+     * Ground tiles of all stacks that have been changed since the last check.
+     */
+    std::vector<fcn_gate_layout::tile> dirty{};
+    /**
+     * Results of the last check of an incremental checker.
+     */
+    struct check_cache
+    {
+        /**
+         * Violations of each rule in the order of create_rules.
+         */
+        std::vector<nlohmann::json> violations;
+        /**
+         * Layout dimensions at the time of the check.
+         */
+        std::size_t x, y, z;
+        /**
+         * Flag to indicate that the layout was regularly clocked at the time of the check.
+         */
+        bool regular;
+    };
+    /**
+     * Cached results of the last check if the checker is incremental.
+     */
+    std::optional<check_cache> cache{};
     /**
      * Escape color sequence for passed checks followed by a check mark.
      */
@@ -86,78 +145,113 @@ private:
      */
     const char* WARNING = "[\033[38;5;226m!\033[0m]";
     /**
-     * Logs information about the given tile in the given report. Assigned vertex' or edges' ids are logged in this
-     * process under the tile position.
-     *
-     * @param t Tile whose assigned elements are the be logged.
-     * @param report JSON report to be extended by the given tile.
-     */
-    void log_tile(const fcn_gate_layout::tile& t, nlohmann::json& report) const noexcept;
-    /**
-     * Generates a summarizing one liner for a design rule check.
-     *
-     * @param msg Message to output in success case. For failure, a "not" will be added as a prefix.
-     * @param chk Result of the check.
-     * @param brk Flag to indicate that a failure is design breaking. If it's not, msg is printed as a warning.
-     * @return Formatted summary message.
+     * Everything rules can inspect about an occupied tile. It is determined once per tile and shared by all rules.
      */
-    std::string summary(std::string&& msg, const bool chk, const bool brk) const noexcept;
+    struct tile_context
+    {
+        /**
+         * Inspected tile.
+         */
+        const fcn_gate_layout::tile& t;
+        /**
+         * Data assigned to t.
+         */
+        const fcn_gate_layout::tile_data& td;
+        /**
+         * Tiles with incoming and outgoing data flow to t.
+         */
+        const std::vector<fcn_gate_layout::tile> inp, out;
+    };
     /**
-     * Checks for too many assigned logic edges on a single tile.
-     *
-     * @param report Report to add results to.
-     * @return Check summary as a one liner.
+     * A single design rule. It is violated by each tile its predicates return true for. Either predicate can be empty
+     * if the rule does not inspect the respective kind of tiles.
      */
-    std::string wire_count_check(nlohmann::json& report) const noexcept;
+    struct design_rule
+    {
+        /**
+         * Section of the summary the rule is listed in.
+         */
+        const char* section;
+        /**
+         * Key of the rule's violations in the report.
+         */
+        const char* key;
+        /**
+         * Message to output in success case. For failure, a "not" will be added as a prefix.
+         */
+        std::string msg;
+        /**
+         * Flag to indicate that a violation is design breaking. If it's not, msg is printed as a warning.
+         */
+        bool breaking;
+        /**
+         * Predicate to inspect each occupied tile with.
+         */
+        std::function<bool(const tile_context&)> tile_violated{};
+        /**
+         * Predicate to inspect each PI/PO with.
+         */
+        std::function<bool(const fcn_gate_layout::tile&)> io_violated{};
+        /**
+         * Tiles violating the rule.
+         */
+        nlohmann::json violations{};
+        /**
+         * Flag to indicate that no tile violated the rule.
+         */
+        bool passed = true;
+    };
     /**
-     * Checks for non-PO tiles with successors and non-PI tiles without predecessors.
+     * Creates all design rules in the order they are listed in the summary.
      *
-     * @param report Report to add results to.
-     * @return Check summary as a one liner.
+     * @return All design rules to check.
      */
-    std::string missing_connections_check(nlohmann::json& report) const noexcept;
+    std::vector<design_rule> create_rules() const noexcept;
     /**
-     * Check for wires crossing gates.
+     * Inspects all occupied tiles and all PI/POs with all given rules and records violations.
      *
-     * @param report Report to add results to.
-     * @return Check summary as a one liner.
+     * @param rules Rules to check.
      */
-    std::string crossing_gates_check(nlohmann::json& report) const noexcept;
+    void inspect(std::vector<design_rule>& rules) const noexcept;
     /**
-     * Checks for unclocked non-empty tiles.
+     * Updates the cached violations of all rules by re-inspecting all changed stacks and their adjacent ones. PI/POs
+     * are inspected entirely again.
      *
-     * @param report Report to add results to.
-     * @return Check summary as a one liner.
+     * @param rules Rules to check. Their violations are set to the updated ones.
      */
-    std::string tile_clocking_check(nlohmann::json& report) const noexcept;
+    void revise(std::vector<design_rule>& rules) noexcept;
     /**
-     * Checks for directions assigned against clocking.
+     * Inspects all PI/POs with all given rules and records violations.
      *
-     * @param report Report to add results to.
-     * @return Check summary as a one liner.
+     * @param rules Rules to check.
      */
-    std::string direction_check(nlohmann::json& report) const noexcept;
+    void inspect_io(std::vector<design_rule>& rules) const noexcept;
     /**
-     * Checks if no PI/PO is assigned to a wire or an empty tile.
+     * Inspects the given tile with all given rules and logs violations in the respective buffer.
      *
-     * @param report Report to add results to.
-     * @return Check summary as a one liner.
+     * @param rules Rules to check.
+     * @param p Position of the tile in the layout's tile storage.
+     * @param violations One buffer per rule to log violating tiles in.
      */
-    std::string operation_io_check(nlohmann::json& report) const noexcept;
+    void inspect_tile(const std::vector<design_rule>& rules, const std::size_t p,
+                      std::vector<nlohmann::json>& violations) const noexcept;
     /**
-     * Checks if all PI/POs are designated pins.
+     * Logs information about the given tile in the given report. Assigned vertex' or edges' ids are logged in this
+     * process under the tile position.
      *
-     * @param report Report to add results to.
-     * @return Check summary as a one liner.
+     * @param t Tile whose assigned elements are the be logged.
+     * @param report JSON report to be extended by the given tile.
      */
-    std::string io_port_check(nlohmann::json& report) const noexcept;
+    void log_tile(const fcn_gate_layout::tile& t, nlohmann::json& report) const noexcept;
     /**
-     * Checks if all PI/POs are located at the layout's borders.
+     * Generates a summarizing one liner for a design rule check.
      *
-     * @param report Report to add results to.
-     * @return Check summary as a one liner.
+     * @param msg Message to output in success case. For failure, a "not" will be added as a prefix.
+     * @param chk Result of the check.
+     * @param brk Flag to indicate that a failure is design breaking. If it's not, msg is printed as a warning.
+     * @return Formatted summary message.
      */
-    std::string border_io_check(nlohmann::json& report) const noexcept;
+    std::string summary(std::string&& msg, const bool chk, const bool brk) const noexcept;
 };
 
 
@@ -3,23 +3,31 @@
 //
 #include "equivalence_checker.h"
 
-equivalence_checker::equivalence_checker(fcn_gate_layout_ptr fgl, std::size_t faults)
+equivalence_checker::equivalence_checker(fcn_gate_layout_ptr fgl, std::size_t faults, unsigned threads)
         :
         two_layouts{false},
         fgl1{std::move(fgl)},
-        faults{faults}
+        faults{faults},
+        threads{threads}
 {}
 
-equivalence_checker::equivalence_checker(fcn_gate_layout_ptr fgl1, fcn_gate_layout_ptr fgl2, std::size_t faults)
+equivalence_checker::equivalence_checker(fcn_gate_layout_ptr fgl1, fcn_gate_layout_ptr fgl2, std::size_t faults,
+                                         unsigned threads)
         :
         two_layouts{true},
         fgl1{std::move(fgl1)},
         fgl2{std::move(fgl2)},
-        faults{faults}
+        faults{faults},
+        threads{threads}
 {}
 
 equivalence_checker::check_result equivalence_checker::check()
 {
+    tiles_visited = 0ul;
+    extraction_time = std::chrono::duration<double>{0};
+    simulated_patterns = 0ul;
+    simulation_time = std::chrono::duration<double>{0};
+
     logic_network_ptr ln1, ln2;
     if (two_layouts)
     {
@@ -42,6 +50,17 @@ equivalence_checker::check_result equivalence_checker::check()
         ln2 = fgl1->get_network();
     }
 
+    // simulation exposes most non-equivalences much faster than SAT
+    if (ln1->num_pis() == ln2->num_pis() && ln1->num_pos() == ln2->num_pos())
+    {
+        if (auto verdict = simulation_check(*ln1, *ln2); verdict)
+            return *verdict;
+
+        // split the remaining SAT problem into PO cones if multiple threads are requested
+        if (threads != 1u)
+            return cone_check(ln1, ln2);
+    }
+
     auto miter = generate_miter<mockturtle::aig_network>(ln1, ln2);
     if (!miter)
     {
@@ -53,6 +72,10 @@ equivalence_checker::check_result equivalence_checker::check()
         j["runtime"] = 0.0f;
         j["miterGenerated"] = false;
         j["error"] = false;
+        j["tilesVisited"] = tiles_visited;
+        j["extractionRuntime"] = extraction_time.count();
+        j["simulatedPatterns"] = simulated_patterns;
+        j["simulationRuntime"] = simulation_time.count();
         return check_result{false, j};
     }
 
@@ -85,9 +108,209 @@ equivalence_checker::check_result equivalence_checker::check()
     log["miterGenerated"] = true;
     log["error"] = err;
     log["runtime"] = runtime;
+    log["stage"] = "SAT";
+    log["tilesVisited"] = tiles_visited;
+    log["extractionRuntime"] = extraction_time.count();
+    log["simulatedPatterns"] = simulated_patterns;
+    log["simulationRuntime"] = simulation_time.count();
     return check_result{eq, log};
 }
 
+std::vector<logic_network::vertex>
+equivalence_checker::cone_order(const logic_network& ln, const logic_network::vertex v) const noexcept
+{
+    std::vector<logic_network::vertex> order{};
+    std::unordered_set<logic_network::vertex> visited{v};
+
+    // iterative DFS whose post-order is a topological order of the cone
+    std::vector<std::pair<logic_network::vertex, bool>> stack{{v, false}};
+    while (!stack.empty())
+    {
+        const auto [n, expanded] = stack.back();
+        stack.pop_back();
+
+        if (expanded)
+        {
+            order.push_back(n);
+            continue;
+        }
+
+        stack.emplace_back(n, true);
+        for (auto&& pre : ln.inv_adjacent_vertices(n, true))
+        {
+            if (visited.insert(pre).second)
+                stack.emplace_back(pre, false);
+        }
+    }
+
+    return order;
+}
+
+equivalence_checker::check_result equivalence_checker::cone_check(logic_network_ptr ln1, logic_network_ptr ln2)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    // POs of both networks correspond to each other by their port names
+    std::vector<logic_network::vertex> pos1{}, pos2{};
+    ln1->foreach_po([&pos1](const auto _po){pos1.push_back(_po);});
+    ln2->foreach_po([&pos2](const auto _po){pos2.push_back(_po);});
+
+    struct cone_result
+    {
+        bool checked = false;
+        std::optional<bool> equivalent{};
+        std::vector<bool> counter_example{};
+        double runtime = 0.0;
+    };
+    std::vector<cone_result> results(pos1.size());
+
+    // workers fetch cones one after another and stop as soon as any cone yields a counterexample
+    std::atomic<std::size_t> next{0ul};
+    std::atomic<bool> refuted{false};
+    const auto worker = [&]()
+    {
+        for (std::size_t i; !refuted && (i = next++) < pos1.size();)
+        {
+            auto miter = generate_cone_miter<mockturtle::aig_network>(ln1, pos1[i], ln2, pos2[i]);
+
+            mockturtle::equivalence_checking_stats stats;
+            const auto result = mockturtle::equivalence_checking(*miter, {}, &stats);
+
+            results[i] = cone_result{true, result, stats.counter_example, mockturtle::to_seconds(stats.time_total)};
+
+            // undecided cones do not refute equivalence; others may still yield a counterexample
+            if (result && !*result)
+                refuted = true;
+        }
+    };
+
+    const auto num_threads = std::min(static_cast<std::size_t>(threads ? threads :
+                                      std::max(std::thread::hardware_concurrency(), 1u)), pos1.size());
+
+    std::vector<std::thread> workers{};
+    workers.reserve(num_threads);
+    for (auto i = 0ul; i < num_threads; ++i)
+        workers.emplace_back(worker);
+    for (auto& w : workers)
+        w.join();
+
+    // merge statistics of all checked cones
+    bool mismatch = false;
+    std::size_t cones_checked = 0ul;
+    double cone_runtime = 0.0, max_cone_runtime = 0.0;
+    std::vector<std::string> undecided{};
+    nlohmann::json log;
+    for (std::size_t i = 0ul; i < results.size(); ++i)
+    {
+        const auto& r = results[i];
+        if (!r.checked)
+            continue;
+
+        ++cones_checked;
+        cone_runtime += r.runtime;
+        max_cone_runtime = std::max(max_cone_runtime, r.runtime);
+
+        if (!r.equivalent)
+        {
+            undecided.push_back(ln1->get_port_name(pos1[i]));
+        }
+        // report the first PO with a counterexample
+        else if (!*r.equivalent && !mismatch)
+        {
+            mismatch = true;
+            log["counter-example"] = r.counter_example;
+            log["mismatchingOutput"] = ln1->get_port_name(pos1[i]);
+        }
+    }
+
+    // equivalence is only proven if no cone remained undecided
+    const auto eq = !mismatch && undecided.empty();
+
+    log["equivalent"] = eq;
+    log["undecidedOutputs"] = undecided;
+    log["miterGenerated"] = true;
+    log["error"] = false;
+    log["runtime"] = std::chrono::duration<double>{std::chrono::steady_clock::now() - start}.count();
+    log["stage"] = "SAT";
+    log["threads"] = num_threads;
+    log["cones"] = results.size();
+    log["conesChecked"] = cones_checked;
+    log["coneRuntime"] = cone_runtime;
+    log["maxConeRuntime"] = max_cone_runtime;
+    log["tilesVisited"] = tiles_visited;
+    log["extractionRuntime"] = extraction_time.count();
+    log["simulatedPatterns"] = simulated_patterns;
+    log["simulationRuntime"] = simulation_time.count();
+
+    return check_result{eq, log};
+}
+
+std::optional<equivalence_checker::check_result>
+equivalence_checker::simulation_check(const logic_network& ln1, const logic_network& ln2)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    const logic_network_simulator sim1{ln1}, sim2{ln2};
+
+    // cover all input assignments if there are few enough
+    const auto exhaustive = sim1.num_pis() < 64ul && (1ul << sim1.num_pis()) <= SIMULATION_PATTERNS;
+    simulated_patterns = exhaustive ? 1ul << sim1.num_pis() : SIMULATION_PATTERNS;
+    const auto patterns = exhaustive ? logic_network_simulator::exhaustive_patterns(sim1.num_pis()) :
+                          logic_network_simulator::random_patterns(sim1.num_pis(), simulated_patterns, SIMULATION_SEED);
+
+    const auto out1 = sim1.simulate(patterns, simulated_patterns), out2 = sim2.simulate(patterns, simulated_patterns);
+
+    // find the first pattern on which any PO differs
+    std::optional<std::pair<std::size_t, std::size_t>> mismatch{};
+    for (std::size_t po = 0ul; po < out1.size() && !mismatch; ++po)
+    {
+        for (std::size_t w = 0ul; w < out1[po].size(); ++w)
+        {
+            if (const auto diff = out1[po][w] ^ out2[po][w]; diff != 0ul)
+            {
+                mismatch = std::make_pair(po, w * 64ul + static_cast<std::size_t>(__builtin_ctzll(diff)));
+                break;
+            }
+        }
+    }
+
+    simulation_time = std::chrono::steady_clock::now() - start;
+
+    // all POs remain undecided
+    if (!mismatch && !exhaustive)
+        return std::nullopt;
+
+    nlohmann::json log;
+    log["equivalent"] = !mismatch;
+    log["miterGenerated"] = false;
+    log["error"] = false;
+    log["runtime"] = simulation_time.count();
+    log["stage"] = "simulation";
+
+    if (mismatch)
+    {
+        const auto [po, pattern] = *mismatch;
+
+        std::vector<bool> counter_example{};
+        counter_example.reserve(patterns.size());
+        for (const auto& p : patterns)
+            counter_example.push_back(logic_network_simulator::get_bit(p, pattern));
+
+        std::vector<logic_network::vertex> pos{};
+        ln1.foreach_po([&pos](const auto _po){pos.push_back(_po);});
+
+        log["counter-example"] = counter_example;
+        log["mismatchingOutput"] = ln1.get_port_name(pos[po]);
+    }
+
+    log["tilesVisited"] = tiles_visited;
+    log["extractionRuntime"] = extraction_time.count();
+    log["simulatedPatterns"] = simulated_patterns;
+    log["simulationRuntime"] = simulation_time.count();
+
+    return check_result{!mismatch, log};
+}
+
 logic_network_ptr equivalence_checker::extract(fcn_gate_layout_ptr fgl)
 {
     using extraction_cache = std::unordered_map<fcn_gate_layout::tile, logic_network::vertex,
@@ -189,7 +412,11 @@ logic_network_ptr equivalence_checker::extract(fcn_gate_layout_ptr fgl)
 
 logic_network_ptr equivalence_checker::extract_network(fcn_gate_layout_ptr fgl)
 {
+    const auto start = std::chrono::steady_clock::now();
+
     vmap.clear();
+    expanded_gates.clear();
+    expanded_wires.clear();
     auto ln = std::make_shared<logic_network>("");
 
     for (auto& g : fgl->get_pis())
@@ -204,8 +431,17 @@ logic_network_ptr equivalence_checker::extract_network(fcn_gate_layout_ptr fgl)
                 auto v = ln->create_pi("");
                 ln->create_edge(v, pi);
             }
-            for (auto& p : fgl->outgoing_data_flow(g, fcn_gate_layout::gate_or_wire{*(fgl->get_logic_vertex(g))}))
-                extract_network(fgl, ln, pi, p.first, p.second);
+
+            ++tiles_visited;
+            expanded_gates.emplace(g);
+
+            std::vector<extraction_item> worklist{};
+            // push in reverse order so that outgoing data flow is followed in its original order
+            for (auto& p : fgl->outgoing_data_flow(g, fcn_gate_layout::gate_or_wire{*(fgl->get_logic_vertex(g))})
+                           | iter::reversed)
+                worklist.push_back({pi, p.first, p.second});
+
+            extract_network(fgl, ln, std::move(worklist));
         }
         catch (std::exception& e)
         {
@@ -213,38 +449,52 @@ logic_network_ptr equivalence_checker::extract_network(fcn_gate_layout_ptr fgl)
         }
     }
 
+    extraction_time += std::chrono::steady_clock::now() - start;
+
     return ln;
 }
 
-void
-equivalence_checker::extract_network(fcn_gate_layout_ptr& fgl, logic_network_ptr& ln, logic_network::vertex& path_beginning,
-                                     fcn_gate_layout::tile current, fcn_gate_layout::gate_or_wire gwc)
+void equivalence_checker::extract_network(fcn_gate_layout_ptr& fgl, logic_network_ptr& ln,
+                                          std::vector<extraction_item>&& worklist)
 {
-
-    bool is_gate = fgl->is_gate_tile(current);
-    logic_network::vertex v;
-    if (is_gate)
+    while (!worklist.empty())
     {
-        //look up current coordinates in vertex map; if they do not have an entry, create it and emplace it in the map.
-        auto coords = std::make_tuple(current[0], current[1], current[2]);
-        try
-        {
-            v = vmap.at(coords);
-        }
-        catch (...)
+        auto [path_beginning, current, gwc] = worklist.back();
+        worklist.pop_back();
+
+        ++tiles_visited;
+
+        bool is_gate = fgl->is_gate_tile(current);
+        logic_network::vertex v;
+        if (is_gate)
         {
-            v = create_vertex(ln, fgl, current);
-            vmap[coords] = v;
+            //look up current coordinates in vertex map; if they do not have an entry, create it and emplace it in the map.
+            auto coords = std::make_tuple(current[0], current[1], current[2]);
+            try
+            {
+                v = vmap.at(coords);
+            }
+            catch (...)
+            {
+                v = create_vertex(ln, fgl, current);
+                vmap[coords] = v;
+            }
+            //since current tile has a gate, the current path is completed
+            if (auto e = ln->get_edge(path_beginning, v); !e)
+                ln->create_edge(path_beginning, v);
+
+            //a gate's fan-out cone only needs to be followed once, no matter how many paths lead to it
+            if (!expanded_gates.emplace(current).second)
+                continue;
         }
-        //since current tile has a gate, the current path is completed
-        if (auto e = ln->get_edge(path_beginning, v); !e)
-            ln->create_edge(path_beginning, v);
-    }
-    for (auto& g : fgl->outgoing_data_flow(current, gwc))
-    {
+        else if (auto w = std::get_if<logic_network::edge>(&gwc);
+                 w && !expanded_wires.emplace(current, *w).second)
+            continue;
+
         //if current tile was a gate, then new paths start from its vertex, otherwise continue with old path
-        //because current tile is a wire
-        extract_network(fgl, ln, is_gate ? v : path_beginning, g.first, g.second);
+        //because current tile is a wire; push in reverse order so that the first data flow is handled first
+        for (auto& g : fgl->outgoing_data_flow(current, gwc) | iter::reversed)
+            worklist.push_back({is_gate ? v : path_beginning, g.first, g.second});
     }
 }
 
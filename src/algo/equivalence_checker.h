@@ -7,6 +7,7 @@
 
 #include "fcn_gate_layout.h"
 #include "logic_network.h"
+#include "logic_network_simulator.h"
 #include <itertools.hpp>
 #include <nlohmann/json.hpp>
 #include <mockturtle/networks/aig.hpp>
@@ -15,6 +16,10 @@
 #include <boost/functional/hash.hpp>
 #include <random>
 #include <stack>
+#include <chrono>
+#include <unordered_set>
+#include <thread>
+#include <atomic>
 
 /**
  * Performs equality checking of logic networks and can extract them from gate layouts for that purpose.
@@ -37,16 +42,21 @@ public:
      * Constructor for checking gate layout against original logic network.
      *
      * @param fgl Gate layout to check against original logic network
+     * @param faults Maximum number of faults to randomly insert into the extracted network
+     * @param threads Number of threads to check PO cones concurrently with (0 uses all available)
      */
-    explicit equivalence_checker(fcn_gate_layout_ptr fgl, std::size_t faults = 0);
+    explicit equivalence_checker(fcn_gate_layout_ptr fgl, std::size_t faults = 0, unsigned threads = 1u);
 
     /**
      * Constructor for checking equality of two gate layouts.
      *
      * @param fgl1 First gate layout of equality check
      * @param fgl2 Second gate layout of equality check
+     * @param faults Maximum number of faults to randomly insert into the extracted networks
+     * @param threads Number of threads to check PO cones concurrently with (0 uses all available)
      */
-    explicit equivalence_checker(fcn_gate_layout_ptr fgl1, fcn_gate_layout_ptr fgl2, std::size_t faults = 0);
+    explicit equivalence_checker(fcn_gate_layout_ptr fgl1, fcn_gate_layout_ptr fgl2, std::size_t faults = 0,
+                                 unsigned threads = 1u);
 
     /**
      * Performs the equivalence check according to parameters passed to this class during
@@ -61,6 +71,23 @@ public:
 private:
     template<class Ntk>
     Ntk convert(logic_network_ptr ln) const noexcept
+    {
+        auto order = ln->topological_sort();
+        std::reverse(order.begin(), order.end());
+
+        return convert<Ntk>(ln, order);
+    }
+    /**
+     * Converts the given vertices of a logic network into a mockturtle network. All PIs are created regardless of
+     * order such that counterexamples always refer to all of them.
+     *
+     * @tparam Ntk mockturtle network type.
+     * @param ln Logic network to convert.
+     * @param order Vertices to convert in topological order. Each one's fan-ins have to be contained.
+     * @return Converted network.
+     */
+    template<class Ntk>
+    Ntk convert(logic_network_ptr ln, const std::vector<logic_network::vertex>& order) const noexcept
     {
         using vertex_cache = std::unordered_map<logic_network::vertex, typename Ntk::signal,
                                                 boost::hash<logic_network::vertex>>;
@@ -70,11 +97,14 @@ private:
 
         auto create_node = [&](const auto _n) -> std::optional<typename Ntk::signal>
         {
+            // keep the range alive while iterating over it
+            auto fan_in = ln->inv_adjacent_vertices(_n, true);
+
             switch (auto op = ln->get_op(_n); op)
             {
                 case operation::AND:
                 {
-                    auto iter = ln->inv_adjacent_vertices(_n, true).begin();
+                    auto iter = fan_in.begin();
                     auto pre_1 = cache.at(*iter);
                     std::advance(iter, 1);
                     auto pre_2 = cache.at(*iter);
@@ -82,7 +112,7 @@ private:
                 }
                 case operation::OR:
                 {
-                    auto iter = ln->inv_adjacent_vertices(_n, true).begin();
+                    auto iter = fan_in.begin();
                     auto pre_1 = cache.at(*iter);
                     std::advance(iter, 1);
                     auto pre_2 = cache.at(*iter);
@@ -90,12 +120,12 @@ private:
                 }
                 case operation::NOT:
                 {
-                    auto pre_1 = cache.at(*(ln->inv_adjacent_vertices(_n, true).begin()));
+                    auto pre_1 = cache.at(*(fan_in.begin()));
                     return ntk.create_not(pre_1);
                 }
                 case operation::MAJ:
                 {
-                    auto iter = ln->inv_adjacent_vertices(_n, true).begin();
+                    auto iter = fan_in.begin();
                     auto pre_1 = cache.at(*iter);
                     std::advance(iter, 1);
                     auto pre_2 = cache.at(*iter);
@@ -109,7 +139,7 @@ private:
                 }
                 case operation::PO:
                 {
-                    auto iter = ln->inv_adjacent_vertices(_n, true).begin();
+                    auto iter = fan_in.begin();
                     auto pre_1 = cache.at(*iter);
                     ntk.create_po(pre_1, ln->get_port_name(_n));
 
@@ -122,7 +152,7 @@ private:
                 }
                 default:
                 {
-                    auto iter = ln->inv_adjacent_vertices(_n, true).begin();
+                    auto iter = fan_in.begin();
                     auto pre_1 = cache.at(*iter);
                     return ntk.create_buf(pre_1);
                 }
@@ -136,7 +166,7 @@ private:
                                cache[pi] = *_n;
                        });
 
-        for (auto&& n : iter::reversed(ln->topological_sort()))
+        for (auto&& n : order)
         {
             if (ln->is_pi(n))
                 continue;
@@ -154,6 +184,42 @@ private:
         auto ntk1 = convert<Ntk>(ln1), ntk2 = convert<Ntk>(ln2);
         return mockturtle::miter<Ntk>(ntk1, ntk2);
     }
+    /**
+     * Generates a miter of the cones of a single PO of each given network. Logic shared by both cones is merged by
+     * the structural hashing of Ntk.
+     *
+     * @tparam Ntk mockturtle network type.
+     * @param ln1 First logic network.
+     * @param po1 PO of ln1.
+     * @param ln2 Second logic network.
+     * @param po2 PO of ln2 corresponding to po1.
+     * @return Miter of both cones.
+     */
+    template<class Ntk>
+    std::optional<Ntk> generate_cone_miter(logic_network_ptr ln1, const logic_network::vertex po1,
+                                           logic_network_ptr ln2, const logic_network::vertex po2) const noexcept
+    {
+        auto ntk1 = convert<Ntk>(ln1, cone_order(*ln1, po1)), ntk2 = convert<Ntk>(ln2, cone_order(*ln2, po2));
+        return mockturtle::miter<Ntk>(ntk1, ntk2);
+    }
+    /**
+     * Returns the transitive fan-in cone of the given vertex including itself in topological order.
+     *
+     * @param ln Logic network containing v.
+     * @param v Vertex whose cone is desired.
+     * @return Cone of v in topological order.
+     */
+    std::vector<logic_network::vertex> cone_order(const logic_network& ln, const logic_network::vertex v) const noexcept;
+    /**
+     * Checks the given networks for equivalence by checking a miter per PO cone instead of one for the whole
+     * networks. Cones are checked concurrently by the configured number of threads which stop as soon as any PO is
+     * refuted by a counterexample. Cones the solver cannot decide are logged as undecided and prevent equivalence.
+     *
+     * @param ln1 First logic network.
+     * @param ln2 Second logic network with the same number of PIs and POs as ln1.
+     * @return Merged result of all cone checks.
+     */
+    check_result cone_check(logic_network_ptr ln1, logic_network_ptr ln2);
 
     logic_network_ptr extract(fcn_gate_layout_ptr fgl);
     /**
@@ -176,16 +242,34 @@ private:
     logic_network_ptr extract_network(fcn_gate_layout_ptr fgl);
 
     /**
-     * Fills the given logic network by reading paths between gates and adding them to it.
+     * Element of the extraction worklist, i.e. a gate or wire on a tile that is reached by a path starting at a
+     * given logic vertex.
+     */
+    struct extraction_item
+    {
+        /**
+         * The beginning of the path as a logic vertex.
+         */
+        logic_network::vertex path_beginning;
+        /**
+         * The reached tile.
+         */
+        fcn_gate_layout::tile current;
+        /**
+         * The gate_or_wire object for current.
+         */
+        fcn_gate_layout::gate_or_wire gwc;
+    };
+    /**
+     * Fills the given logic network by reading paths between gates and adding them to it. Paths are followed via
+     * an explicit worklist in depth-first order. Each gate or wire on a tile is expanded only once such that
+     * reconvergent fan-outs do not lead to repeated traversals of the same cones.
      *
      * @param fgl The gate layout whose logic network is to be extracted
      * @param ln The logic network to fill with information
-     * @param path_beginning The beginning of the current path as a logic vertex
-     * @param current The current tile
-     * @param gwc The gate_or_wire object for current
+     * @param worklist Initial worklist, whose last element is handled first.
      */
-    void extract_network(fcn_gate_layout_ptr& fgl, logic_network_ptr& ln, logic_network::vertex& path_beginning,
-                         fcn_gate_layout::tile current, fcn_gate_layout::gate_or_wire gwc);
+    void extract_network(fcn_gate_layout_ptr& fgl, logic_network_ptr& ln, std::vector<extraction_item>&& worklist);
 
     /**
      * Creates a vertex in the given logic network based on the operation of the passed tile.
@@ -214,10 +298,58 @@ private:
      * Maximum number of faults to randomly insert into the circuit prior to equivalence checking.
      */
     std::size_t faults;
+    /**
+     * Number of threads to check PO cones with. If it is 1, the networks are checked by a single miter instead.
+     */
+    unsigned threads;
     /**
      * Maps tile coordinates to their corresponding logic network vertices.
      */
     std::unordered_map<std::tuple<int, int, int>, logic_network::vertex, boost::hash<std::tuple<int, int, int>>> vmap{};
+    /**
+     * Gate tiles whose outgoing data flow has already been followed during extraction.
+     */
+    std::unordered_set<fcn_gate_layout::tile, boost::hash<fcn_gate_layout::tile>> expanded_gates{};
+    /**
+     * Wire segments whose outgoing data flow has already been followed during extraction.
+     */
+    std::unordered_set<std::pair<fcn_gate_layout::tile, logic_network::edge>,
+                       boost::hash<std::pair<fcn_gate_layout::tile, logic_network::edge>>> expanded_wires{};
+    /**
+     * Number of tiles visited during all extractions of the last check.
+     */
+    std::size_t tiles_visited = 0ul;
+    /**
+     * Time spent in all extractions of the last check.
+     */
+    std::chrono::duration<double> extraction_time{0};
+    /**
+     * Number of random patterns simulated before resorting to SAT. If the networks have few enough PIs for this many
+     * patterns to cover all input assignments, they are simulated exhaustively and SAT is not needed at all.
+     */
+    static constexpr const std::size_t SIMULATION_PATTERNS = 4096ul;
+    /**
+     * Seed for the random patterns such that simulation verdicts are reproducible.
+     */
+    static constexpr const std::uint64_t SIMULATION_SEED = 0x5eedul;
+    /**
+     * Number of patterns simulated during the last check.
+     */
+    std::size_t simulated_patterns = 0ul;
+    /**
+     * Time spent in simulation during the last check.
+     */
+    std::chrono::duration<double> simulation_time{0};
+    /**
+     * Simulates both given networks on the same input patterns as a cheap first stage of the equivalence check. Any
+     * mismatching PO refutes equivalence immediately. Since random patterns cannot prove equivalence, all POs remain
+     * undecided otherwise unless the simulation was exhaustive.
+     *
+     * @param ln1 First logic network.
+     * @param ln2 Second logic network with the same number of PIs and POs as ln1.
+     * @return Result of the check if simulation could decide it and std::nullopt otherwise.
+     */
+    std::optional<check_result> simulation_check(const logic_network& ln1, const logic_network& ln2);
 
     std::vector<std::tuple<int, int, int>> pi_vector;
 
@@ -3,60 +3,464 @@
 //
 
 #include "exact_pr.h"
+#include "orthogonal_pr.h"
+#include "fcn_timing_view.h"
 
 
 exact_pr::exact_pr(logic_network_ptr ln, exact_pr_config&& config)
         :
         place_route(std::move(ln)),
         config{config},
-        lower_bound{static_cast<unsigned>(network->vertex_count(config.io_ports))},
-        solver{ctx}
+        upper_bound{config.upper_bound}
 {
-    layout = std::make_shared<fcn_gate_layout>(std::move(*config.scheme), network);
-    initialize_vcl_map();
-    set_timeout(config.timeout);
+    layout = std::make_shared<fcn_gate_layout>(fcn_clocking_scheme{*config.scheme}, network);
+    determine_lower_bound();
 }
 
 place_route::pr_result exact_pr::perform_place_and_route()
+{
+    // there is no layout at all
+    if (!degrees_supported)
+        return pr_result{false, nlohmann::json{{"runtime", 0}, {"lower_bound", lower_bound}, {"skipped_dimensions", 0},
+                                               {"optimal", false}}};
+
+    if (config.warm_start)
+        warm_start();
+
+    if (config.threads == 1u)
+        return explore_sequentially();
+    else
+        return explore_concurrently();
+}
+
+void exact_pr::determine_lower_bound() noexcept
+{
+    const auto& clk = *config.scheme;
+    const auto num_clocks = static_cast<long>(clk.num_clocks);
+
+    // number of vertices
+    lower_bound = static_cast<unsigned>(network->vertex_count(config.io_ports));
+
+    // maximum numbers of outgoing and incoming clocked neighbors a tile can have
+    std::size_t max_out = 0ul, max_in = 0ul;
+    if (clk.regular)
+    {
+        monotone_scheme = clk.num_clocks > 2u;
+        for (auto y : iter::range(clk.cutout_y))
+        {
+            for (auto x : iter::range(clk.cutout_x))
+            {
+                const auto z = clk.scheme[y][x];
+                const std::vector<fcn_clock::zone> neighbors
+                        {clk.scheme[(y + clk.cutout_y - 1) % clk.cutout_y][x],
+                         clk.scheme[y][(x + 1) % clk.cutout_x],
+                         clk.scheme[(y + 1) % clk.cutout_y][x],
+                         clk.scheme[y][(x + clk.cutout_x - 1) % clk.cutout_x]};
+
+                auto is_next = [&](const fcn_clock::zone _n){return _n == (z + 1) % clk.num_clocks;};
+                auto is_prev = [&](const fcn_clock::zone _n){return (_n + 1) % clk.num_clocks == z;};
+
+                max_out = std::max(max_out, static_cast<std::size_t>(std::count_if(neighbors.cbegin(), neighbors.cend(), is_next)));
+                max_in  = std::max(max_in, static_cast<std::size_t>(std::count_if(neighbors.cbegin(), neighbors.cend(), is_prev)));
+
+                // eastern and southern neighbors are the next zone
+                if (!is_next(neighbors[1]) || !is_next(neighbors[2]))
+                    monotone_scheme = false;
+            }
+        }
+    }
+    else  // irregular clocking allows for up to 4 connections per tile
+    {
+        max_out = 4ul;
+        max_in  = 4ul;
+    }
+
+    // fan-in and fan-out requirements
+    for (auto&& v : network->vertices(config.io_ports))
+    {
+        const auto out = network->out_degree(v, config.io_ports), in = network->in_degree(v, config.io_ports);
+        if (out > max_out || in > max_in || (!clk.regular && out + in > 4ul))
+        {
+            degrees_supported = false;
+            lower_bound = std::numeric_limits<unsigned>::max();
+            return;
+        }
+
+        if (out > 1ul || in > 1ul)
+            branching_network = true;
+    }
+
+    // critical path in number of vertices
+    std::unordered_map<logic_vertex, std::size_t> path_length{};
+    for (auto&& v : network->topological_sort() | iter::reversed)
+    {
+        if (network->is_constant(v) || (!config.io_ports && network->is_io(v)))
+            continue;
+
+        std::size_t length = 0ul;
+        for (auto&& e : network->in_edges(v, config.io_ports))
+            length = std::max(length, path_length[network->source(e)]);
+
+        path_length[v] = length + 1;
+        critical_path_length = std::max(critical_path_length, length + 1);
+    }
+
+    // monotone schemes need x + y - 1 >= critical path length, which a 1 x L layout fulfills with L tiles already;
+    // branching vertices need neighbors in both directions though, i.e., x = 2 is the narrowest layout then
+    if (monotone_scheme && branching_network && critical_path_length > 3ul)
+        lower_bound = std::max(lower_bound, static_cast<unsigned>(2 * (critical_path_length - 1)));
+
+    // fan-in paths that differ in length by more than the clock zone period need wires to be balanced
+    if (!config.path_discrepancy)
+    {
+        long imbalance = 0l;
+        auto measure = [&](const logic_vertex _v)
+        {
+            // same paths as fanin_length uses
+            auto paths = network->get_all_paths(_v, config.io_ports);
+            if (paths.empty())
+                return;
+
+            auto [min_p, max_p] = std::minmax_element(paths.cbegin(), paths.cend(),
+                                                      [](const logic_network::edge_path& p1,
+                                                         const logic_network::edge_path& p2)
+                                                      {return p1.size() < p2.size();});
+
+            // PIs' clock zones can compensate for num_clocks - 1 tiles
+            imbalance = std::max(imbalance, static_cast<long>(max_p->size() - min_p->size()) - (num_clocks - 1));
+        };
+
+        if (config.io_ports)
+        {
+            for (auto&& po : network->get_pos())
+                measure(po);
+        }
+        else
+        {
+            for (auto&& po : network->get_pos())
+            {
+                for (auto&& v : network->inv_adjacent_vertices(po))
+                    measure(v);
+            }
+        }
+
+        // a single latched wire tile can compensate for any imbalance
+        auto wires = config.artificial_latch ? std::min(imbalance, 1l) : imbalance;
+
+        if (!config.crossings)
+            lower_bound += static_cast<unsigned>(std::max(wires, 0l));
+        // crossing tiles could host a vertex as well or two wires of the same path
+        else if (config.crossings_limit)
+            lower_bound = std::max(lower_bound, static_cast<unsigned>(std::max(wires - config.crossings_limit, 0l)));
+        else
+            lower_bound = std::max(lower_bound, static_cast<unsigned>(std::max((wires + 1) / 2, 0l)));
+    }
+
+    // I/Os at the border
+    if (config.border_io)
+    {
+        std::unordered_set<logic_vertex> ios{};
+        if (config.io_ports)
+        {
+            for (auto&& pi : network->get_pis())
+                ios.insert(pi);
+            for (auto&& po : network->get_pos())
+                ios.insert(po);
+        }
+        else
+        {
+            for (auto&& pi : network->get_pis())
+            {
+                for (auto&& v : network->adjacent_vertices(pi))
+                    ios.insert(v);
+            }
+            for (auto&& po : network->get_pos())
+            {
+                for (auto&& v : network->inv_adjacent_vertices(po))
+                    ios.insert(v);
+            }
+        }
+        border_io_count = ios.size();
+
+        // all tiles of layouts that are at most 2 tiles wide are border tiles, which makes I/Os no further bound
+        // unless x = 2 is the narrowest layout; then, it needs an even number of tiles
+        if (auto y = (border_io_count + 1) / 2; monotone_scheme && branching_network && y > 2ul)
+            lower_bound = std::max(lower_bound, static_cast<unsigned>(2 * y));
+    }
+}
+
+void exact_pr::warm_start()
+{
+    const auto& clk = *config.scheme;
+
+    if (!network->is_AOIG() || !clk.regular || clk.scheme != (clk.num_clocks == 3u ? fcn_clock::twoddwave_3 :
+                                                                                       fcn_clock::twoddwave_4))
+    {
+        warm_start_log = nlohmann::json{{"applicable", false},
+                                        {"reason", "warm start requires an AOIG and a 2DDWave clocking scheme"}};
+        return;
+    }
+
+    orthogonal_pr ortho{network, static_cast<unsigned>(clk.num_clocks), config.io_ports};
+    auto result = ortho.perform_place_and_route();
+    if (!result.success)
+    {
+        warm_start_log = nlohmann::json{{"applicable", false}, {"reason", "orthogonal_pr could not find a layout"}};
+        return;
+    }
+
+    auto fgl = ortho.get_layout();
+    for (auto&& t : fgl->ground_layer())
+    {
+        if (auto v = fgl->get_logic_vertex(t); v)
+            placement_hints.emplace(network->index(*v), t);
+    }
+
+    const auto bb = fgl->determine_bounding_box();
+    const auto area = static_cast<unsigned>((bb.max_x + 1) * (bb.max_y + 1));
+    // a fixed size cannot be bounded any further
+    const auto feasible = !config.fixed_size && area <= upper_bound && satisfies_config(*fgl);
+
+    if (feasible)
+    {
+        warm_start_layout = fgl;
+        upper_bound = area - 1;
+    }
+
+    warm_start_log = nlohmann::json{{"applicable", true},
+                                    {"runtime", result.json["runtime"]},
+                                    {"area", area},
+                                    {"feasible", feasible}};
+}
+
+bool exact_pr::satisfies_config(const fcn_gate_layout& fgl) const noexcept
+{
+    // crossings
+    if (const auto crossings = static_cast<unsigned>(fgl.crossing_count()); crossings)
+    {
+        if (!config.crossings || (config.crossings_limit && crossings > config.crossings_limit))
+            return false;
+
+        // crossings are restricted to wires
+        for (auto&& t : fgl.crossing_layers())
+        {
+            if (fgl.is_wire_tile(t) && fgl.is_gate_tile(fgl.below(t)))
+                return false;
+        }
+    }
+
+    // wire lengths
+    if (config.wire_limit)
+    {
+        std::unordered_map<logic_edge, unsigned, boost::hash<logic_edge>> wire_lengths{};
+        auto count_wires = [&](const layout_tile& _t)
+        {
+            for (auto&& e : fgl.get_logic_edges(_t))
+                ++wire_lengths[e];
+        };
+
+        for (auto&& t : fgl.ground_layer())
+            count_wires(t);
+        for (auto&& t : fgl.crossing_layers())
+            count_wires(t);
+
+        if (std::any_of(wire_lengths.cbegin(), wire_lengths.cend(),
+                        [this](const auto& _wl){return _wl.second > config.wire_limit;}))
+            return false;
+    }
+
+    // border I/Os
+    if (config.border_io)
+    {
+        auto is_border = [&fgl](const layout_tile& _t){return fgl.is_border_tile(_t);};
+        auto pis = fgl.get_pis(), pos = fgl.get_pos();
+        if (!std::all_of(pis.begin(), pis.end(), is_border) || !std::all_of(pos.begin(), pos.end(), is_border))
+            return false;
+    }
+
+    // path balancing
+    if (!config.path_discrepancy)
+    {
+        // fan-in paths are balanced iff their delays do not differ
+        if (fcn_timing_view{fgl}.max_delay_difference())
+            return false;
+    }
+
+    return true;
+}
+
+place_route::pr_result exact_pr::fall_back(nlohmann::json&& log, const bool exhausted)
+{
+    if (!warm_start_layout)
+    {
+        log["optimal"] = false;
+        return pr_result{false, log};
+    }
+
+    layout = warm_start_layout;
+    log["optimal"] = exhausted && !is_narrower_viable(layout->x() * layout->y());
+
+    return pr_result{true, log};
+}
+
+void exact_pr::report_progress(const fcn_dimension_xy& dim, const z3::check_result result,
+                               nlohmann::json&& statistics, const chrono::time_point start)
+{
+    nlohmann::json event{{"area", dim[X] * dim[Y]},
+                         {"dimension", {dim[X], dim[Y]}},
+                         {"elapsed", calc_runtime(start, chrono::now())},
+                         {"result", result == z3::sat ? "sat" : result == z3::unsat ? "unsat" : "unknown"},
+                         {"statistics", std::move(statistics)}};
+
+    if (config.progress)
+        config.progress(event);
+
+    progress_log.push_back(std::move(event));
+}
+
+bool exact_pr::is_viable(const fcn_dimension_xy& dim) const noexcept
+{
+    if (monotone_scheme && dim[X] + dim[Y] < critical_path_length + 1)
+        return false;
+
+    if (monotone_scheme && branching_network && (dim[X] == 1 || dim[Y] == 1))
+        return false;
+
+    // 1 tile wide layouts consist of border tiles only
+    const auto border_tiles = dim[X] == 1 || dim[Y] == 1 ? dim[X] * dim[Y] : 2 * dim[X] + 2 * dim[Y] - 4;
+    if (config.border_io && border_tiles < border_io_count)
+        return false;
+
+    return true;
+}
+
+bool exact_pr::is_narrower_viable(const std::size_t area) const noexcept
+{
+    // a dimension of extent 1 is viable for all greater extents as well
+    return monotone_scheme && !branching_network && area > 1ul &&
+           is_viable(fcn_dimension_xy{area - 1ul, 1ul});
+}
+
+fcn_dimension_xy exact_pr::bounding_canvas(const fcn_dimension_xy& dim) const noexcept
+{
+    fcn_dimension_xy canvas{dim};
+
+    if (!config.incremental || config.fixed_size)
+        return canvas;
+
+    const auto dim_area = dim[X] * dim[Y];
+    const auto limit = config.canvas_limit ? std::size_t{config.canvas_limit} : 2 * dim_area;
+
+    // dimensions are explored in ascending order of their areas and in the order factorize yields them
+    for (auto area = dim_area; area <= upper_bound && area <= limit; ++area)
+    {
+        for (auto&& d : factorize(static_cast<unsigned>(area)))
+        {
+            if (!is_viable(d))
+                continue;
+
+            const fcn_dimension_xy span{std::max(canvas[X], d[X]), std::max(canvas[Y], d[Y])};
+            if (span[X] * span[Y] > limit)
+                return canvas;
+
+            canvas = span;
+        }
+    }
+
+    return canvas;
+}
+
+bool exact_pr::is_transposition_invariant() const noexcept
+{
+    const auto& clk = *config.scheme;
+
+    if (!clk.regular)
+        return true;
+
+    if (clk.cutout_x != clk.cutout_y)
+        return false;
+
+    for (auto y : iter::range(clk.cutout_y))
+    {
+        for (auto x : iter::range(clk.cutout_x))
+        {
+            if (clk.scheme[y][x] != clk.scheme[x][y])
+                return false;
+        }
+    }
+
+    return true;
+}
+
+place_route::pr_result exact_pr::explore_sequentially()
 {
     unsigned time_left = config.timeout;
     auto start = chrono::now(), round = chrono::now();
 
-    for (auto i = config.fixed_size ? config.upper_bound : lower_bound; i <= config.upper_bound; ++i) // <= to prevent overflow
+    // dimensions whose transposition is known to be unsatisfiable can be skipped
+    const auto skip_transposed = config.symmetry_breaking && is_transposition_invariant();
+    std::set<fcn_dimension_xy> unsat_dimensions{};
+    // number of dimensions that were skipped because they cannot host a layout
+    std::size_t skipped = 0ul;
+    // flag to indicate that some dimension could not be decided
+    auto undecided = false;
+
+    smt_handler handler{network, layout, config, placement_hints};
+    handler.set_timeout(time_left);
+
+    auto log = [&](const chrono::time_point stop) -> nlohmann::json
     {
-        for (auto& dimension : factorize(i))
-        {
-            layout->resize(std::move(dimension));
+        using std::chrono::duration_cast, std::chrono::milliseconds;
 
-            initialize_tv_map();
-            initialize_te_map();
-            initialize_tc_map();
-            initialize_tp_map();
+        nlohmann::json j{{"runtime", calc_runtime(start, stop)},
+                         {"encoding_time", duration_cast<milliseconds>(handler.get_encoding_time()).count()},
+                         {"solve_time", duration_cast<milliseconds>(handler.get_solving_time()).count()},
+                         {"lower_bound", lower_bound},
+                         {"skipped_dimensions", skipped},
+                         {"progress", progress_log}};
 
-            if (!layout->is_regularly_clocked())
-                initialize_tcl_map();
+        if (config.warm_start)
+            j["warm_start"] = warm_start_log;
 
-            if (config.artificial_latch && !config.path_discrepancy)
-                initialize_tl_map();
+        return j;
+    };
+
+    for (auto i = config.fixed_size ? upper_bound : lower_bound; i <= upper_bound; ++i) // <= to prevent overflow
+    {
+        for (auto& dimension : factorize(i))
+        {
+            if (!is_viable(dimension))
+            {
+                ++skipped;
+                continue;
+            }
+
+            if (skip_transposed && unsat_dimensions.count(fcn_dimension_xy{dimension[Y], dimension[X]}))
+                continue;
 
             try
             {
-                solver.push();
-                generate_smt_instance();
+                const auto dim = dimension;
+                handler.update(std::move(dimension), bounding_canvas(dim));
+
+                auto result = handler.solve();
+                report_progress(dim, result, handler.get_statistics(), start);
 
-                switch (solver.check())
+                if (result == z3::sat)
                 {
-                    case z3::sat:
-                    {
-                        auto stop = chrono::now();
-                        assign_layout();
+                    auto stop = chrono::now();
+                    handler.store_solution();
 
-                        return pr_result{true, nlohmann::json{{"runtime", calc_runtime(start, stop)}}};
-                    }
-                    default:
-                        break;
+                    // the layout is only minimal if all dimensions prior to it were decided
+                    auto j = log(stop);
+                    j["optimal"] = !undecided && !is_narrower_viable(i);
+
+                    return pr_result{true, j};
                 }
-                solver.pop();
+                else if (result == z3::unsat && skip_transposed)
+                    unsat_dimensions.insert(dim);
+                else if (result == z3::unknown)
+                    undecided = true;
 
                 // update timeout
                 auto time_elapsed = calc_runtime(round, chrono::now());
@@ -65,27 +469,380 @@ place_route::pr_result exact_pr::perform_place_and_route()
                 if (!time_left)
                     throw z3::exception("timeout");
 
-                set_timeout(time_left);
+                handler.set_timeout(time_left);
                 round = chrono::now();
             }
             catch (const z3::exception&)
             {
-                return pr_result{false, nlohmann::json{{"runtime", calc_runtime(start, chrono::now())}}};
+                return fall_back(log(chrono::now()), false);
             }
         }
     }
 
-    return pr_result{false, nlohmann::json{{"runtime", calc_runtime(start, chrono::now())}}};
+    return fall_back(log(chrono::now()), !undecided);
 }
 
-void exact_pr::set_timeout(const unsigned t)
+place_route::pr_result exact_pr::explore_concurrently()
+{
+    const auto num_threads = config.threads ? config.threads : std::max(std::thread::hardware_concurrency(), 1u);
+    auto start = chrono::now();
+
+    // guards all of the following exploration state that is shared between workers
+    std::mutex mutex{};
+    // next area to factorize and its dimensions that have not been handed out yet
+    auto area = config.fixed_size ? upper_bound : lower_bound;
+    std::vector<fcn_dimension_xy> dimensions{};
+    auto exhausted = area > upper_bound;
+    // dimensions are numbered by their position in the sequential exploration order
+    std::size_t position = 0ul;
+    // handlers that are currently solving their dimension mapped to its position
+    std::unordered_map<std::size_t, smt_handler*> running{};
+    // position and layout of the first satisfiable dimension found so far
+    std::optional<std::size_t> best_position{};
+    fcn_gate_layout_ptr best_layout = nullptr;
+    // first position whose dimension could not be decided in time
+    std::optional<std::size_t> undecided_position{};
+    // dimensions whose transposition is known to be unsatisfiable can be skipped
+    const auto skip_transposed = config.symmetry_breaking && is_transposition_invariant();
+    std::set<fcn_dimension_xy> unsat_dimensions{};
+    // number of dimensions that were skipped because they cannot host a layout
+    std::size_t skipped = 0ul;
+
+    // dimensions behind a satisfiable or an undecidable one do not need to be explored any further
+    auto is_obsolete = [&](const std::size_t _p) -> bool
+    {
+        return (best_position && _p > *best_position) || (undecided_position && _p > *undecided_position);
+    };
+
+    // has to be called while holding the lock
+    auto interrupt_obsolete = [&]() -> void
+    {
+        for (auto& [p, h] : running)
+        {
+            if (is_obsolete(p))
+                h->interrupt();
+        }
+    };
+
+    // has to be called while holding the lock
+    auto mark_undecided = [&](const std::size_t _p) -> void
+    {
+        if (!undecided_position || _p < *undecided_position)
+            undecided_position = _p;
+
+        interrupt_obsolete();
+    };
+
+    auto next_dimension = [&]() -> std::optional<std::pair<std::size_t, fcn_dimension_xy>>
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+
+        // all further dimensions would be obsolete
+        if (is_obsolete(position))
+            return std::nullopt;
+
+        while (true)
+        {
+            while (dimensions.empty())
+            {
+                if (exhausted)
+                    return std::nullopt;
+
+                dimensions = factorize(area);
+                // hand out dimensions from the back in the order factorize yields them
+                std::reverse(dimensions.begin(), dimensions.end());
+
+                // comparing before incrementing prevents an overflow
+                exhausted = config.fixed_size || area == upper_bound;
+                ++area;
+            }
+
+            auto dimension = dimensions.back();
+            dimensions.pop_back();
+
+            if (!is_viable(dimension))
+            {
+                ++skipped;
+                continue;
+            }
+
+            if (!(skip_transposed && unsat_dimensions.count(fcn_dimension_xy{dimension[Y], dimension[X]})))
+                return std::make_pair(position++, dimension);
+        }
+    };
+
+    // accumulated encoding and solving times of all handlers
+    chrono::duration encoding_time{0}, solving_time{0};
+
+    auto explore = [&]() -> void
+    {
+        fcn_gate_layout_ptr fgl = nullptr;
+        std::unique_ptr<smt_handler> handler = nullptr;
+
+        // has to be called while holding the lock
+        auto discard_handler = [&]() -> void
+        {
+            if (handler)
+            {
+                encoding_time += handler->get_encoding_time();
+                solving_time  += handler->get_solving_time();
+            }
+
+            handler = nullptr;
+            fgl     = nullptr;
+        };
+
+        while (auto next = next_dimension())
+        {
+            auto& [p, dimension] = *next;
+            const auto dim = dimension;
+
+            try
+            {
+                // incremental handlers can be reused for the next dimension
+                if (!handler)
+                {
+                    fgl     = std::make_shared<fcn_gate_layout>(fcn_clocking_scheme{*config.scheme}, network);
+                    handler = std::make_unique<smt_handler>(network, fgl, config, placement_hints);
+                }
+
+                handler->update(std::move(dimension), bounding_canvas(dim));
+
+                {
+                    std::lock_guard<std::mutex> lock{mutex};
+
+                    if (is_obsolete(p))
+                        continue;
+
+                    auto time_elapsed = calc_runtime(start, chrono::now());
+                    if (time_elapsed >= config.timeout)
+                    {
+                        mark_undecided(p);
+                        continue;
+                    }
+
+                    handler->set_timeout(static_cast<unsigned>(config.timeout - time_elapsed));
+                    running.emplace(p, handler.get());
+                }
+
+                auto result = handler->solve();
+                if (result == z3::sat)
+                    handler->store_solution();
+
+                auto statistics = handler->get_statistics();
+
+                std::lock_guard<std::mutex> lock{mutex};
+                running.erase(p);
+                report_progress(dim, result, std::move(statistics), start);
+
+                if (result == z3::sat)
+                {
+                    if (!best_position || p < *best_position)
+                    {
+                        best_position = p;
+                        best_layout   = fgl;
+
+                        interrupt_obsolete();
+                    }
+                }
+                else if (result == z3::unsat && skip_transposed)
+                    unsat_dimensions.insert(dim);
+                // unknown results of obsolete dimensions stem from interruption
+                else if (result == z3::unknown && !is_obsolete(p))
+                    mark_undecided(p);
+
+                // the layout holds a solution or the context might have been interrupted
+                if (!config.incremental || result == z3::sat || is_obsolete(p))
+                    discard_handler();
+            }
+            catch (const z3::exception&)
+            {
+                std::lock_guard<std::mutex> lock{mutex};
+                running.erase(p);
+
+                if (!is_obsolete(p))
+                    mark_undecided(p);
+
+                discard_handler();
+            }
+        }
+
+        std::lock_guard<std::mutex> lock{mutex};
+        discard_handler();
+    };
+
+    std::vector<std::thread> workers{};
+    workers.reserve(num_threads);
+    for (auto i = 0u; i < num_threads; ++i)
+        workers.emplace_back(explore);
+
+    for (auto& w : workers)
+        w.join();
+
+    auto stop = chrono::now();
+
+    using std::chrono::duration_cast, std::chrono::milliseconds;
+    nlohmann::json log{{"runtime", calc_runtime(start, stop)},
+                       {"encoding_time", duration_cast<milliseconds>(encoding_time).count()},
+                       {"solve_time", duration_cast<milliseconds>(solving_time).count()},
+                       {"lower_bound", lower_bound},
+                       {"skipped_dimensions", skipped},
+                       {"threads", num_threads},
+                       {"progress", progress_log}};
+
+    if (config.warm_start)
+        log["warm_start"] = warm_start_log;
+
+    // the layout is only minimal if all dimensions prior to it were decided
+    if (best_position && !(undecided_position && *undecided_position < *best_position))
+    {
+        layout = best_layout;
+        log["optimal"] = !is_narrower_viable(layout->x() * layout->y());
+
+        return pr_result{true, log};
+    }
+    // a dimension prior to the best one could not be decided in time but the best one is still smaller than any
+    // warm start layout because the search is bounded by it
+    else if (best_position)
+    {
+        layout = best_layout;
+        log["optimal"] = false;
+
+        return pr_result{true, log};
+    }
+
+    return fall_back(std::move(log), !undecided_position);
+}
+
+exact_pr::smt_handler::smt_handler(logic_network_ptr ln, fcn_gate_layout_ptr fgl, const exact_pr_config& c,
+                                   const placement_hint_map& h)
+        :
+        network{std::move(ln)},
+        layout{std::move(fgl)},
+        config{c},
+        hints{h},
+        solver{ctx}
+{
+    initialize_vcl_map();
+}
+
+void exact_pr::smt_handler::update(fcn_dimension_xy&& dim, const fcn_dimension_xy& bound)
+{
+    auto encoding_start = chrono::now();
+    dimension = dim;
+
+    if (config.incremental)
+    {
+        // current instance can represent the new dimension by deactivating tiles
+        if (canvas && dimension[X] <= (*canvas)[X] && dimension[Y] <= (*canvas)[Y])
+            return;
+
+        // encode once for all dimensions to be explored next such that learned lemmas carry over between them
+        const fcn_dimension_xy span{std::max(bound[X], dimension[X]), std::max(bound[Y], dimension[Y])};
+
+        // remove the instance generated for the former canvas
+        if (canvas)
+            solver.pop();
+
+        canvas = span;
+        layout->resize(fcn_dimension_xy{span});
+        clear_tile_maps();
+    }
+    else
+        layout->resize(fcn_dimension_xy{dimension});
+
+    initialize_tv_map();
+    initialize_te_map();
+    initialize_tc_map();
+    initialize_tp_map();
+
+    if (!layout->is_regularly_clocked())
+        initialize_tcl_map();
+
+    if (config.artificial_latch && !config.path_discrepancy)
+        initialize_tl_map();
+
+    if (config.incremental)
+    {
+        initialize_ta_map();
+
+        solver.push();
+        generate_smt_instance();
+    }
+
+    encoding_time += chrono::now() - encoding_start;
+}
+
+z3::check_result exact_pr::smt_handler::solve()
+{
+    if (config.incremental)
+    {
+        z3::expr_vector assumptions{ctx};
+        for (auto&& t : layout->ground_layer())
+            assumptions.push_back(is_active(t) ? get_ta(t) : not get_ta(t));
+
+        auto solving_start = chrono::now();
+        auto result = check(assumptions);
+        solving_time += chrono::now() - solving_start;
+
+        return result;
+    }
+
+    auto encoding_start = chrono::now();
+    solver.push();
+    generate_smt_instance();
+    encoding_time += chrono::now() - encoding_start;
+
+    auto solving_start = chrono::now();
+    auto result = check(z3::expr_vector{ctx});
+    solving_time += chrono::now() - solving_start;
+
+    // keep the instance on the stack for model extraction
+    if (result != z3::sat)
+        solver.pop();
+
+    return result;
+}
+
+void exact_pr::smt_handler::interrupt() noexcept
+{
+    ctx.interrupt();
+}
+
+place_route::chrono::duration exact_pr::smt_handler::get_encoding_time() const noexcept
+{
+    return encoding_time;
+}
+
+place_route::chrono::duration exact_pr::smt_handler::get_solving_time() const noexcept
+{
+    return solving_time;
+}
+
+nlohmann::json exact_pr::smt_handler::get_statistics() const
+{
+    const auto stats = solver.statistics();
+
+    nlohmann::json j = nlohmann::json::object();
+    for (auto i : iter::range(stats.size()))
+    {
+        if (stats.is_uint(i))
+            j[stats.key(i)] = stats.uint_value(i);
+        else
+            j[stats.key(i)] = stats.double_value(i);
+    }
+
+    return j;
+}
+
+void exact_pr::smt_handler::set_timeout(const unsigned t)
 {
     z3::params p{ctx};
     p.set("timeout", t);
     solver.set(p);
 }
 
-void exact_pr::initialize_tv_map()
+void exact_pr::smt_handler::initialize_tv_map()
 {
     for (auto&& t : layout->ground_layer())
     {
@@ -99,7 +856,7 @@ void exact_pr::initialize_tv_map()
     }
 }
 
-void exact_pr::initialize_te_map()
+void exact_pr::smt_handler::initialize_te_map()
 {
     for (auto&& t : layout->ground_layer())
     {
@@ -113,7 +870,7 @@ void exact_pr::initialize_te_map()
     }
 }
 
-void exact_pr::initialize_tc_map()
+void exact_pr::smt_handler::initialize_tc_map()
 {
     for (auto&& t1 : layout->ground_layer())
     {
@@ -138,7 +895,7 @@ void exact_pr::initialize_tc_map()
     }
 }
 
-void exact_pr::initialize_tp_map()
+void exact_pr::smt_handler::initialize_tp_map()
 {
     for (auto&& t1 : layout->ground_layer())
     {
@@ -152,7 +909,7 @@ void exact_pr::initialize_tp_map()
     }
 }
 
-void exact_pr::initialize_vcl_map()
+void exact_pr::smt_handler::initialize_vcl_map()
 {
     auto initialize = [this](const logic_vertex _v) -> void
     {
@@ -176,7 +933,7 @@ void exact_pr::initialize_vcl_map()
     }
 }
 
-void exact_pr::initialize_tcl_map()
+void exact_pr::smt_handler::initialize_tcl_map()
 {
     for (auto&& t : layout->ground_layer())
     {
@@ -186,7 +943,7 @@ void exact_pr::initialize_tcl_map()
     }
 }
 
-void exact_pr::initialize_tl_map()
+void exact_pr::smt_handler::initialize_tl_map()
 {
     for (auto&& t : layout->ground_layer())
     {
@@ -196,43 +953,74 @@ void exact_pr::initialize_tl_map()
     }
 }
 
-z3::expr exact_pr::get_tv(const layout_tile& t, const logic_vertex v)
+void exact_pr::smt_handler::initialize_ta_map()
+{
+    for (auto&& t : layout->ground_layer())
+    {
+        const auto t_i = layout->index(t);
+        z3_expr_proxy ep{ctx.bool_const(fmt::format("ta_{}", t_i).c_str())};
+        ta_map.emplace(t_i, ep);
+    }
+}
+
+void exact_pr::smt_handler::clear_tile_maps() noexcept
+{
+    tv_map.clear();
+    te_map.clear();
+    tc_map.clear();
+    tp_map.clear();
+    tcl_map.clear();
+    tl_map.clear();
+    ta_map.clear();
+}
+
+z3::expr exact_pr::smt_handler::get_tv(const layout_tile& t, const logic_vertex v)
 {
     return tv_map.at(std::make_pair(layout->index(t), network->index(v)))[0u];
 }
 
-z3::expr exact_pr::get_te(const layout_tile& t, const logic_edge& e)
+z3::expr exact_pr::smt_handler::get_te(const layout_tile& t, const logic_edge& e)
 {
     return te_map.at(std::make_pair(layout->index(t), std::make_pair(network->index(network->source(e)),
                                                                      network->index(network->target(e)))))[0u];
 }
 
-z3::expr exact_pr::get_tc(const layout_tile& t1, const layout_tile& t2)
+z3::expr exact_pr::smt_handler::get_tc(const layout_tile& t1, const layout_tile& t2)
 {
     return tc_map.at(std::make_pair(layout->index(t1), layout->index(t2)))[0u];
 }
 
-z3::expr exact_pr::get_tp(const layout_tile& t1, const layout_tile& t2)
+z3::expr exact_pr::smt_handler::get_tp(const layout_tile& t1, const layout_tile& t2)
 {
     return tp_map.at(std::make_pair(layout->index(t1), layout->index(t2)))[0u];
 }
 
-z3::expr exact_pr::get_vcl(const logic_vertex v)
+z3::expr exact_pr::smt_handler::get_vcl(const logic_vertex v)
 {
     return vcl_map.at(network->index(v))[0u];
 }
 
-z3::expr exact_pr::get_tcl(const layout_tile& t)
+z3::expr exact_pr::smt_handler::get_tcl(const layout_tile& t)
 {
     return tcl_map.at(layout->index(t))[0u];
 }
 
-z3::expr exact_pr::get_tl(const layout_tile& t)
+z3::expr exact_pr::smt_handler::get_tl(const layout_tile& t)
 {
     return tl_map.at(layout->index(t))[0u];
 }
 
-z3::expr exact_pr::mk_eq(const z3::expr_vector& v) const noexcept
+z3::expr exact_pr::smt_handler::get_ta(const layout_tile& t)
+{
+    return ta_map.at(layout->index(t))[0u];
+}
+
+bool exact_pr::smt_handler::is_active(const layout_tile& t) const noexcept
+{
+    return t[X] < dimension[X] && t[Y] < dimension[Y];
+}
+
+z3::expr exact_pr::smt_handler::mk_eq(const z3::expr_vector& v) const noexcept
 {
     z3::expr_vector eq{v.ctx()};
     for (auto i : iter::range(1u, v.size()))
@@ -241,7 +1029,7 @@ z3::expr exact_pr::mk_eq(const z3::expr_vector& v) const noexcept
     return z3::mk_and(eq);
 }
 
-void exact_pr::tile_ite_counters(const logic_edge& e, z3::expr_vector& ve) noexcept
+void exact_pr::smt_handler::tile_ite_counters(const logic_edge& e, z3::expr_vector& ve) noexcept
 {
     z3::expr one  = ctx.real_val(1);
     z3::expr zero = ctx.real_val(0);
@@ -258,7 +1046,7 @@ void exact_pr::tile_ite_counters(const logic_edge& e, z3::expr_vector& ve) noexc
     }
 }
 
-void exact_pr::restrict_tile_elements()
+void exact_pr::smt_handler::restrict_tile_elements()
 {
     for (auto&& t : layout->ground_layer())
     {
@@ -290,7 +1078,7 @@ void exact_pr::restrict_tile_elements()
     }
 }
 
-void exact_pr::restrict_vertices()
+void exact_pr::smt_handler::restrict_vertices()
 {
     for (auto&& v : network->vertices(config.io_ports))
     {
@@ -303,7 +1091,7 @@ void exact_pr::restrict_vertices()
     }
 }
 
-void exact_pr::restrict_clocks()
+void exact_pr::smt_handler::restrict_clocks()
 {
     for (auto&& t : layout->ground_layer())
     {
@@ -317,7 +1105,7 @@ void exact_pr::restrict_clocks()
     }
 }
 
-void exact_pr::restrict_latches()
+void exact_pr::smt_handler::restrict_latches()
 {
     auto zero = ctx.real_val(0);
 
@@ -341,7 +1129,24 @@ void exact_pr::restrict_latches()
     solver.minimize(z3::sum(ve));
 }
 
-void exact_pr::define_adjacent_vertex_tiles()
+void exact_pr::smt_handler::deactivate_tiles()
+{
+    for (auto&& t : layout->ground_layer())
+    {
+        z3::expr_vector ow{ctx};
+        for (auto&& v : network->vertices(config.io_ports))
+            ow.push_back(get_tv(t, v));
+
+        for (auto&& e : network->edges(config.io_ports))
+            ow.push_back(get_te(t, e));
+
+        // connections and paths of empty tiles are prohibited by define_number_of_connections
+        if (!ow.empty())
+            solver.add(z3::implies(not get_ta(t), z3::atmost(ow, 0u)));
+    }
+}
+
+void exact_pr::smt_handler::define_adjacent_vertex_tiles()
 {
     for (auto&& t : layout->ground_layer())
     {
@@ -377,7 +1182,7 @@ void exact_pr::define_adjacent_vertex_tiles()
     }
 }
 
-void exact_pr::define_inv_adjacent_vertex_tiles()
+void exact_pr::smt_handler::define_inv_adjacent_vertex_tiles()
 {
     for (auto&& t : layout->ground_layer())
     {
@@ -413,7 +1218,7 @@ void exact_pr::define_inv_adjacent_vertex_tiles()
     }
 }
 
-void exact_pr::define_adjacent_edge_tiles()
+void exact_pr::smt_handler::define_adjacent_edge_tiles()
 {
     for (auto&& t : layout->ground_layer())
     {
@@ -443,7 +1248,7 @@ void exact_pr::define_adjacent_edge_tiles()
     }
 }
 
-void exact_pr::define_inv_adjacent_edge_tiles()
+void exact_pr::smt_handler::define_inv_adjacent_edge_tiles()
 {
     for (auto&& t : layout->ground_layer())
     {
@@ -473,7 +1278,7 @@ void exact_pr::define_inv_adjacent_edge_tiles()
     }
 }
 
-void exact_pr::establish_sub_paths()
+void exact_pr::smt_handler::establish_sub_paths()
 {
     for (auto&& t : layout->ground_layer())
     {
@@ -490,7 +1295,7 @@ void exact_pr::establish_sub_paths()
     }
 }
 
-void exact_pr::establish_transitive_paths()
+void exact_pr::smt_handler::establish_transitive_paths()
 {
     for (auto&& t1 : layout->ground_layer())
     {
@@ -510,13 +1315,13 @@ void exact_pr::establish_transitive_paths()
     }
 }
 
-void exact_pr::eliminate_cycles()
+void exact_pr::smt_handler::eliminate_cycles()
 {
     for (auto&& t : layout->ground_layer())
         solver.add(not get_tp(t, t));
 }
 
-void exact_pr::assign_pi_clockings()
+void exact_pr::smt_handler::assign_pi_clockings()
 {
     auto assign = [&](const logic_vertex _v) -> void
     {
@@ -545,7 +1350,7 @@ void exact_pr::assign_pi_clockings()
     }
 }
 
-void exact_pr::fanin_length()
+void exact_pr::smt_handler::fanin_length()
 {
     using logic_edge_path = logic_network::edge_path;
     auto define_length = [this](const logic_vertex _v) -> void
@@ -601,7 +1406,7 @@ void exact_pr::fanin_length()
     }
 }
 
-void exact_pr::prevent_insufficiencies()
+void exact_pr::smt_handler::prevent_insufficiencies()
 {
     for (auto&& t : layout->ground_layer())
     {
@@ -638,7 +1443,7 @@ void exact_pr::prevent_insufficiencies()
     }
 }
 
-void exact_pr::define_number_of_connections()
+void exact_pr::smt_handler::define_number_of_connections()
 {
     for (auto&& t1 : layout->ground_layer())
     {
@@ -745,7 +1550,7 @@ void exact_pr::define_number_of_connections()
     }
 }
 
-void exact_pr::enforce_border_io()
+void exact_pr::smt_handler::enforce_border_io()
 {
     auto assign_border = [this](const logic_vertex _v)
     {
@@ -754,7 +1559,17 @@ void exact_pr::enforce_border_io()
             if (layout->is_border_tile(t))
                 continue;
 
-            solver.add(not get_tv(t, _v));
+            if (config.incremental)
+            {
+                // t is a border tile of the current dimension if one of its neighbors is inactive
+                z3::expr_vector ina{ctx};
+                for (auto&& at : layout->surrounding_2d(t))
+                    ina.push_back(not get_ta(at));
+
+                solver.add(z3::implies(get_tv(t, _v), z3::mk_or(ina)));
+            }
+            else
+                solver.add(not get_tv(t, _v));
         }
     };
 
@@ -780,7 +1595,7 @@ void exact_pr::enforce_border_io()
     }
 }
 
-void exact_pr::limit_wire_length()
+void exact_pr::smt_handler::limit_wire_length()
 {
     for (auto&& e : network->edges(config.io_ports))
     {
@@ -792,7 +1607,7 @@ void exact_pr::limit_wire_length()
     }
 }
 
-void exact_pr::limit_crossings()
+void exact_pr::smt_handler::limit_crossings()
 {
     z3::expr_vector crossings_counter{ctx};
     for (auto&& t : layout->ground_layer())
@@ -807,12 +1622,135 @@ void exact_pr::limit_crossings()
     solver.add(z3::sum(crossings_counter) <= ctx.real_val(config.crossings_limit));
 }
 
-void exact_pr::generate_smt_instance()
+void exact_pr::smt_handler::break_symmetries()
+{
+    const auto& clk = *config.scheme;
+
+    // smallest shift along one axis that maps the clocking scheme onto itself
+    auto period = [&clk](const bool horizontal) -> std::size_t
+    {
+        if (!clk.regular)
+            return 1ul;
+
+        const auto extent = horizontal ? clk.cutout_x : clk.cutout_y;
+        for (auto d : iter::range(1ul, extent))
+        {
+            auto invariant = true;
+            for (auto y : iter::range(clk.cutout_y))
+            {
+                for (auto x : iter::range(clk.cutout_x))
+                {
+                    if (horizontal ? clk.scheme[y][x] != clk.scheme[y][(x + d) % clk.cutout_x] :
+                                     clk.scheme[y][x] != clk.scheme[(y + d) % clk.cutout_y][x])
+                        invariant = false;
+                }
+            }
+
+            if (invariant)
+                return d;
+        }
+
+        return extent;
+    };
+
+    const auto period_x = period(true), period_y = period(false);
+
+    // collect all variables placing something on tiles within the first period in x and y direction
+    z3::expr_vector band_x{ctx}, band_y{ctx};
+    for (auto&& t : layout->ground_layer())
+    {
+        if (t[X] >= period_x && t[Y] >= period_y)
+            continue;
+
+        for (auto&& v : network->vertices(config.io_ports))
+        {
+            if (t[X] < period_x)
+                band_x.push_back(get_tv(t, v));
+            if (t[Y] < period_y)
+                band_y.push_back(get_tv(t, v));
+        }
+
+        for (auto&& e : network->edges(config.io_ports))
+        {
+            if (t[X] < period_x)
+                band_x.push_back(get_te(t, e));
+            if (t[Y] < period_y)
+                band_y.push_back(get_te(t, e));
+        }
+    }
+
+    // bands spanning the whole layout would not restrict anything
+    if (period_x < layout->x() && !band_x.empty())
+        solver.add(z3::mk_or(band_x));
+    if (period_y < layout->y() && !band_y.empty())
+        solver.add(z3::mk_or(band_y));
+}
+
+void exact_pr::smt_handler::suggest_placement()
+{
+    suggestions.clear();
+
+    for (auto&& [v_i, t] : hints)
+    {
+        // the warm start's placement is only suggested as a whole, i.e., if its bounding box fits the layout
+        if (t[X] >= layout->x() || t[Y] >= layout->y())
+        {
+            suggestions.clear();
+            return;
+        }
+
+        if (auto tv = tv_map.find(std::make_pair(layout->index(t), v_i)); tv != tv_map.end())
+            suggestions.emplace_back(t, tv->second[0]);
+    }
+}
+
+z3::check_result exact_pr::smt_handler::check(const z3::expr_vector& assumptions)
+{
+    // suggestions for inactive tiles are bound to fail, i.e., the current dimension is too small for them
+    if (suggestions.empty() || (config.incremental &&
+        std::any_of(suggestions.cbegin(), suggestions.cend(), [this](const auto& _s){return !is_active(_s.first);})))
+        return solver.check(assumptions);
+
+    // expr_vector copies share their elements, which is why the assumptions are copied one by one
+    z3::expr_vector guided{ctx};
+    for (auto i : iter::range(assumptions.size()))
+        guided.push_back(assumptions[i]);
+    for (auto&& s : suggestions)
+        guided.push_back(s.second);
+
+    auto result = solver.check(guided);
+    if (result == z3::sat)
+        return result;
+
+    // the instance is unsatisfiable regardless of the suggestions if none of them is part of the core
+    if (result == z3::unsat)
+    {
+        const auto core = solver.unsat_core();
+        if (std::none_of(suggestions.cbegin(), suggestions.cend(), [&core](const auto& _s)
+            {
+                for (auto i : iter::range(core.size()))
+                {
+                    if (z3::eq(core[i], _s.second))
+                        return true;
+                }
+                return false;
+            }))
+            return result;
+    }
+
+    // the suggestions conflict with the constraints or the guided call did not terminate
+    return solver.check(assumptions);
+}
+
+void exact_pr::smt_handler::generate_smt_instance()
 {
     // layout constraints
     restrict_tile_elements();
     restrict_vertices();
 
+    if (config.incremental)
+        deactivate_tiles();
+
     // open clocking
     if (!layout->is_regularly_clocked())
         restrict_clocks();
@@ -850,11 +1788,19 @@ void exact_pr::generate_smt_instance()
     if (config.crossings && config.crossings_limit)
         limit_crossings();
 
+    // symmetry breaking constraints
+    if (config.symmetry_breaking && !config.border_io)
+        break_symmetries();
+
+    // warm start constraints
+    if (!hints.empty())
+        suggest_placement();
+
 //    std::cout << solver.assertions() << std::endl;
 
 }
 
-void exact_pr::assign_layout()
+void exact_pr::smt_handler::store_solution()
 {
     auto mdl = solver.get_model();
 
@@ -955,4 +1901,8 @@ void exact_pr::assign_layout()
             layout->assign_latch(t, static_cast<fcn_gate_layout::latch_delay>
                                     (mdl.eval(get_tl(t), true).get_numeral_int()) * layout->num_clocks());
     }
+
+    // inactive tiles are empty and can be cut off
+    if (config.incremental)
+        layout->resize(fcn_dimension_xy{dimension});
 }
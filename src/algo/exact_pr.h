@@ -9,6 +9,8 @@
 #include "exact_pr_config.h"
 #include "fmt/format.h"
 #include <z3++.h>
+#include <thread>
+#include <mutex>
 
 /**
  * An exact P&R approach using SMT solving. This class handles the incremental solver calls and
@@ -19,6 +21,12 @@
  * crossings in the solution. The reduced number of variables saves a considerable amount of
  * runtime. That's why most for-loops iterate over layout->get_ground_layer_tiles() even
  * though it will be mapped to a 3-dimensional layout afterwards.
+ *
+ * If more than one thread is configured, several layout dimensions are explored concurrently, each of them in its
+ * own Z3 context.
+ *
+ * If a warm start is configured, orthogonal_pr is run beforehand. Its placement is suggested to the solver and its
+ * layout is returned if no smaller one can be found in time.
  */
 class exact_pr : public place_route
 {
@@ -114,278 +122,617 @@ private:
      * artificial clock delay.
      */
     using tile_latch_map = std::unordered_map<layout_tile_index, z3_expr_proxy>;
-
-    /**
-     * Arguments, flags, and options for the P&R process stored in one configuration object.
-     */
-    const exact_pr_config config;
-    /**
-     * Lower bound for the number of layout tiles.
-     */
-    const unsigned lower_bound;
-    /**
-     * Context for all Z3 variables used by this instance.
-     */
-    z3::context ctx{};
     /**
-     * SMT solver (utilizing optimize because of performance reasons).
+     * Alias for a map to access Z3 constants associated with tile activity. Used in incremental mode to enable or
+     * disable tiles of a larger layout via assumptions so that it can represent smaller dimensions as well.
      */
-    z3::optimize solver;
+    using tile_activity_map = std::unordered_map<layout_tile_index, z3_expr_proxy>;
     /**
-     * Maps layout tiles and vertices to Z3 constants.
+     * Alias for a map to access the tiles vertices were placed on by the warm start.
      */
-    tile_vertex_map tv_map{};
-    /**
-     * Maps layout tiles and edges to Z3 constants.
-     */
-    tile_edge_map te_map{};
-    /**
-     * Maps layout tile connections to Z3 constants.
-     */
-    tile_connection_map tc_map{};
-    /**
-     * Maps layout tile paths to Z3 constants.
-     */
-    tile_path_map tp_map{};
-    /**
-     * Maps input vertex clock zones to Z3 constants.
-     */
-    vertex_clock_map vcl_map{};
-    /**
-     * Maps layout tiles clock zones to Z3 constants.
-     */
-    tile_clock_map tcl_map{};
-    /**
-     * Maps layout tile latches to Z3 constants.
-     */
-    tile_latch_map tl_map{};
+    using placement_hint_map = std::unordered_map<logic_vertex_index, layout_tile>;
 
     /**
-     * Sets the given timeout for the solver.
-     *
-     * @param t Timeout in ms.
-     */
-    void set_timeout(const unsigned t);
-    /**
-     * Initializes tv_map using layout, netlist and context.
-     *
-     * Creates t * v many variables.
-     */
-    void initialize_tv_map();
-    /**
-     * Initializes te_map using layout, netlist and context.
-     *
-     * Creates t * e many variables.
-     */
-    void initialize_te_map();
-    /**
-     * Initializes tc_map using layout and context.
-     *
-     * Creates one variable for each connection on the layout.
+     * Arguments, flags, and options for the P&R process stored in one configuration object.
      */
-    void initialize_tc_map();
+    const exact_pr_config config;
     /**
-     * Initializes tp_map using layout and context.
-     *
-     * Creates t^2 many variables.
-     */
-    void initialize_tp_map();
+     * Lower bound for the number of layout tiles. It is the maximum of several cheap bounds, see
+     * determine_lower_bound.
+     */
+    unsigned lower_bound = 0u;
+    /**
+     * Upper bound for the number of layout tiles. Initially given by config but it can be tightened by the warm start.
+     */
+    unsigned upper_bound;
+    /**
+     * Number of vertices on the longest path through the placed part of the network.
+     */
+    std::size_t critical_path_length = 0ul;
+    /**
+     * Number of vertices that have to be placed at the layout's borders.
+     */
+    std::size_t border_io_count = 0ul;
+    /**
+     * Flag to indicate that the clocking scheme allows for data flow towards east and south only, like 2DDWave does.
+     */
+    bool monotone_scheme = false;
+    /**
+     * Flag to indicate that a vertex needs two incoming or two outgoing neighbors. Under a monotone clocking scheme,
+     * those can only be provided by layouts that are at least 2 tiles wide in both directions.
+     */
+    bool branching_network = false;
+    /**
+     * Flag to indicate that each vertex's fan-in and fan-out can be provided by a tile under the clocking scheme.
+     */
+    bool degrees_supported = true;
+    /**
+     * Tiles that vertices were placed on by the warm start. Suggested to the solver via assumptions.
+     */
+    placement_hint_map placement_hints{};
+    /**
+     * Layout found by the warm start if it satisfies all constraints given by config. Returned if no smaller layout
+     * can be found.
+     */
+    fcn_gate_layout_ptr warm_start_layout = nullptr;
+    /**
+     * Statistical information about the warm start.
+     */
+    nlohmann::json warm_start_log{};
+    /**
+     * Progress events of all explored dimensions in the order they were reported.
+     */
+    nlohmann::json progress_log = nlohmann::json::array();
+    /**
+     * Sub-class to exact_pr that encapsulates everything that is needed to solve the SMT instance for one layout
+     * dimension, i.e. a Z3 context, a solver, all variable maps, and the constraint generating functions. Z3 contexts
+     * must not be shared between threads. Therefore, each concurrently explored dimension is handled by its own
+     * smt_handler.
+     */
+    class smt_handler
+    {
+    public:
+        /**
+         * Standard constructor.
+         *
+         * @param ln Logic network.
+         * @param fgl Gate layout to work on. Its dimension is altered by update.
+         * @param c Configuration object storing all the bounds, flags, and so on.
+         * @param h Tiles to suggest for the placement of vertices.
+         */
+        smt_handler(logic_network_ptr ln, fcn_gate_layout_ptr fgl, const exact_pr_config& c,
+                    const placement_hint_map& h);
+        /**
+         * Default Destructor.
+         */
+        ~smt_handler() = default;
+        /**
+         * Copy constructor is not available.
+         */
+        smt_handler(const smt_handler& rhs) = delete;
+        /**
+         * Move constructor is not available.
+         */
+        smt_handler(smt_handler&& rhs) = delete;
+        /**
+         * Assignment operator is not available.
+         */
+        smt_handler& operator=(const smt_handler& rhs) = delete;
+        /**
+         * Move assignment operator is not available.
+         */
+        smt_handler& operator=(smt_handler&& rhs) = delete;
+        /**
+         * Resizes the stored layout to the given dimension and creates all variables needed to encode it.
+         *
+         * In incremental mode, the layout is only resized if the given dimension does not fit into the one the
+         * current instance was generated for. In that case, the instance is generated anew for the given bounding
+         * canvas such that subsequent dimensions fit into it as well. Otherwise, nothing has to be done here because
+         * tiles are activated by assumptions.
+         *
+         * @param dim New layout dimension.
+         * @param bound Dimension covering dim and the ones to be explored next (see exact_pr::bounding_canvas).
+         */
+        void update(fcn_dimension_xy&& dim, const fcn_dimension_xy& bound);
+        /**
+         * Generates the SMT instance for the current dimension and checks it for satisfiability. If the instance turns
+         * out to be satisfiable, it is kept on the solver stack so that store_solution can access the model.
+         * Otherwise, it is removed again.
+         *
+         * In incremental mode, the already generated instance is checked under the assumption that exactly the tiles
+         * of the current dimension are active. The instance stays on the solver stack in any case so that learned
+         * lemmas can be reused by the next call.
+         *
+         * @return Result of the solver call.
+         */
+        z3::check_result solve();
+        /**
+         * Assigns vertices, edges and directions to the stored layout with respect to the found model. In incremental
+         * mode, the layout is shrunk to the current dimension afterwards.
+         */
+        void store_solution();
+        /**
+         * Returns the accumulated time spent on generating variables and constraints.
+         *
+         * @return Total encoding time.
+         */
+        chrono::duration get_encoding_time() const noexcept;
+        /**
+         * Returns the accumulated time spent in solver calls.
+         *
+         * @return Total solving time.
+         */
+        chrono::duration get_solving_time() const noexcept;
+        /**
+         * Returns the statistics of the last solver call.
+         *
+         * @return JSON object mapping statistic keys to their values.
+         */
+        nlohmann::json get_statistics() const;
+        /**
+         * Sets the given timeout for the solver.
+         *
+         * @param t Timeout in ms.
+         */
+        void set_timeout(const unsigned t);
+        /**
+         * Interrupts a running solver call which then returns z3::unknown. This function may be called from another
+         * thread than the one which invoked solve.
+         */
+        void interrupt() noexcept;
+
+    private:
+        /**
+         * Logic network to be mapped.
+         */
+        logic_network_ptr network;
+        /**
+         * Layout the found model is going to be assigned to.
+         */
+        fcn_gate_layout_ptr layout;
+        /**
+         * Arguments, flags, and options for the P&R process.
+         */
+        const exact_pr_config& config;
+        /**
+         * Tiles to suggest for the placement of vertices.
+         */
+        const placement_hint_map& hints;
+        /**
+         * Dimension that is currently to be explored.
+         */
+        fcn_dimension_xy dimension{};
+        /**
+         * Dimension of the layout the current instance was generated for. Only used in incremental mode where it can
+         * be larger than dimension.
+         */
+        std::optional<fcn_dimension_xy> canvas{};
+        /**
+         * Accumulated time spent on generating variables and constraints.
+         */
+        chrono::duration encoding_time{0};
+        /**
+         * Accumulated time spent in solver calls.
+         */
+        chrono::duration solving_time{0};
+        /**
+         * Context for all Z3 variables used by this instance.
+         */
+        z3::context ctx{};
+        /**
+         * SMT solver (utilizing optimize because of performance reasons).
+         */
+        z3::optimize solver;
+        /**
+         * Maps layout tiles and vertices to Z3 constants.
+         */
+        tile_vertex_map tv_map{};
+        /**
+         * Maps layout tiles and edges to Z3 constants.
+         */
+        tile_edge_map te_map{};
+        /**
+         * Maps layout tile connections to Z3 constants.
+         */
+        tile_connection_map tc_map{};
+        /**
+         * Maps layout tile paths to Z3 constants.
+         */
+        tile_path_map tp_map{};
+        /**
+         * Maps input vertex clock zones to Z3 constants.
+         */
+        vertex_clock_map vcl_map{};
+        /**
+         * Maps layout tiles clock zones to Z3 constants.
+         */
+        tile_clock_map tcl_map{};
+        /**
+         * Maps layout tile latches to Z3 constants.
+         */
+        tile_latch_map tl_map{};
+        /**
+         * Maps layout tile activities to Z3 constants.
+         */
+        tile_activity_map ta_map{};
+        /**
+         * Placements of vertices suggested by the warm start together with the tiles they refer to.
+         */
+        std::vector<std::pair<layout_tile, z3::expr>> suggestions{};
+
+        /**
+         * Initializes tv_map using layout, netlist and context.
+         *
+         * Creates t * v many variables.
+         */
+        void initialize_tv_map();
+        /**
+         * Initializes te_map using layout, netlist and context.
+         *
+         * Creates t * e many variables.
+         */
+        void initialize_te_map();
+        /**
+         * Initializes tc_map using layout and context.
+         *
+         * Creates one variable for each connection on the layout.
+         */
+        void initialize_tc_map();
+        /**
+         * Initializes tp_map using layout and context.
+         *
+         * Creates t^2 many variables.
+         */
+        void initialize_tp_map();
+        /**
+         * Initializes vcl_map using netlist and context.
+         *
+         * Creates v many variables.
+         */
+        void initialize_vcl_map();
+        /**
+         * Initializes tcl_map using layout and context.
+         *
+         * Creates t many variables.
+         */
+        void initialize_tcl_map();
+        /**
+         * Initializes tl_map using layout and context.
+         *
+         * Creates t many variables
+         */
+        void initialize_tl_map();
+        /**
+         * Initializes ta_map using layout and context.
+         *
+         * Creates t many variables.
+         */
+        void initialize_ta_map();
+        /**
+         * Clears all maps that store tile related variables.
+         */
+        void clear_tile_maps() noexcept;
+        /**
+         * Workaround helper function for getting the variable from a tile_vertex_map
+         * corresponding to a given tile and vertex.
+         *
+         * @param t tile to be considered.
+         * @param v vertex to be considered.
+         * @return First (and only) element from the vector in map found by the keys.
+         */
+        z3::expr get_tv(const layout_tile& t, const logic_vertex v);
+        /**
+         * Workaround helper function for getting the variable from a tile_edge_map
+         * corresponding to a given tile and edge.
+         *
+         * @param t tile to be considered.
+         * @param e edge to be considered.
+         * @return First (and only) element from the vector in map found by the keys.
+         */
+        z3::expr get_te(const layout_tile& t, const logic_edge& e);
+        /**
+         * Workaround helper function for getting the variable from a tile_connection_map
+         * corresponding to two given tiles.
+         *
+         * @param t1 First tile to be considered.
+         * @param t2 Second tile to be considered.
+         * @return First (and only) element from the vector in map found by the keys.
+         */
+        z3::expr get_tc(const layout_tile& t1, const layout_tile& t2);
+        /**
+         * Workaround helper function for getting the variable from a tile_path_map
+         * corresponding to two given tiles.
+         *
+         * @param t1 First tile to be considered.
+         * @param t2 Second tile to be considered.
+         * @return First (and only) element from the vector in map found by the keys.
+         */
+        z3::expr get_tp(const layout_tile& t1, const layout_tile& t2);
+        /**
+         * Workaround helper function for getting the variable from a vertex_clock_map
+         * corresponding to a given vertex.
+         *
+         * @param v vertex to be considered.
+         * @return First (and only) element from the vector in map found by the key.
+         */
+        z3::expr get_vcl(const logic_vertex v);
+        /**
+         * Workaround helper function for getting the variable from a tile_clock_map
+         * corresponding to a given tile.
+         *
+         * @param t tile to be considered.
+         * @return First (and only) element from the vector in map found by the key.
+         */
+        z3::expr get_tcl(const layout_tile& t);
+        /**
+         * Workaround helper function for getting the variable from a tile_latch_map
+         * corresponding to a given tile.
+         *
+         * @param t tile to be considered.
+         * @return First (and only) element from the vector in map found by the key.
+         */
+        z3::expr get_tl(const layout_tile& t);
+        /**
+         * Workaround helper function for getting the variable from a tile_activity_map
+         * corresponding to a given tile.
+         *
+         * @param t tile to be considered.
+         * @return First (and only) element from the vector in map found by the key.
+         */
+        z3::expr get_ta(const layout_tile& t);
+        /**
+         * Checks whether the given tile lies within the current dimension.
+         *
+         * @param t tile to be considered.
+         * @return True iff t is part of the current dimension.
+         */
+        bool is_active(const layout_tile& t) const noexcept;
+        /**
+         * Helper function for generating an equality of an arbitrary number of expressions.
+         *
+         * @param v Vector of expressions to equal.
+         * @return Expression that represents the equality of all elements in v.
+         */
+        z3::expr mk_eq(const z3::expr_vector& v) const noexcept;
+        /**
+         * Constructs a series of expressions to evaluate how many tiles were occupied by a
+         * given edge. Therefore, all te variables are translated to expressions like
+         * ite(te, 1, 0) which allows for applying z3::sum to them. This is a work around because
+         * no such api function for pseudo boolean exists.
+         *
+         * @param e edge to check for.
+         * @param ve Vector of expressions to extend.
+         */
+        void tile_ite_counters(const logic_edge& e, z3::expr_vector& ve) noexcept;
+        /**
+         * Adds constraints to the solver to limit the number of elements that are going to be
+         * assigned to a tile to one (vertex or edge) if no crossings are allowed.
+         * Otherwise, one vertex per tile or two edges per tile can be placed.
+         */
+        void restrict_tile_elements();
+        /**
+         * Adds constraints to the solver to enforce that each vertex is placed exactly once
+         * on exactly one tile.
+         */
+        void restrict_vertices();
+        /**
+         * Adds constraints to the solver to enforce that each clock zone variable has valid
+         * bounds of 0 <= cl <= 3.
+         */
+        void restrict_clocks();
+        /**
+         * Adds constraints to the solver to enforce that latches have to be positive, that vertex tiles cannot be latches,
+         * and that the overall sum of latch values should be minimized.
+         */
+        void restrict_latches();
+        /**
+         * Adds constraints to the solver to enforce that inactive tiles are empty. Used in incremental mode only.
+         */
+        void deactivate_tiles();
+        /**
+         * Adds constraints to the solver to enforce that a tile which was assigned with some
+         * vertex has a successor which is assigned to the adjacent vertex or an outgoing
+         * edge.
+         */
+        void define_adjacent_vertex_tiles();
+        /**
+         * Adds constraints to the solver to enforce that a tile which was assigned with some
+         * vertex has a predecessor which is assigned to the inversely adjacent vertex or an
+         * ingoing edge.
+         */
+        void define_inv_adjacent_vertex_tiles();
+        /**
+         * Adds constraints to the solver to enforce that a tile which was assigned with some
+         * edge has a successor which is assigned to the adjacent vertex or another edge.
+         */
+        void define_adjacent_edge_tiles();
+        /**
+         * Adds constraints to the solver to enforce that a tile which was assigned with some
+         * edge has a predecessor which is assigned to the inversely adjacent vertex or another
+         * edge.
+         */
+        void define_inv_adjacent_edge_tiles();
+        /**
+         * Adds constraints to the solver to map so far established connections between single
+         * tiles to sub-paths. They are spanned transitively by the next set of constraints.
+         */
+        void establish_sub_paths();
+        /**
+         * Adds constraints to the solver to expand the formerly created sub-paths transitively.
+         */
+        void establish_transitive_paths();
+        /**
+         * Adds constraints to the solver to forbid cycles that loop back information. Therefore,
+         * the formerly established paths are used.
+         */
+        void eliminate_cycles();
+        /**
+         * Adds constraints to the solver to ensure that the cl variable of primary input pi
+         * is set to the clocking zone value of the tile pi is assigned to.
+         */
+        void assign_pi_clockings();
+        /**
+         * Adds constraints to the solver to ensure that fan-in paths to the same tile need
+         * to have the same length modulo timing.
+         */
+        void fanin_length();
+        /**
+         * Adds constraints to the solver to prevent edges or vertices to be assigned to tiles
+         * with an insufficient number of predecessors/successors.
+         */
+        void prevent_insufficiencies();
+        /**
+         * Adds constraints to the solver to define the exact number of connection variables to be set
+         * for each tile, i.e. empty tiles are not allowed to have connections at all, edges need to have
+         * one ingoing and one outgoing connection and so on.
+         */
+        void define_number_of_connections();
+        /**
+         * Adds constraints to the solver to position the primary inputs and primary outputs at
+         * the layout's borders. In incremental mode, a tile counts as a border tile if it is located
+         * at the layout's border or next to an inactive tile.
+         */
+        void enforce_border_io();
+        /**
+         * Adds constraints to the solver to limit the number of wire elements that are allowed
+         * to be used to connect two vertices in the layout.
+         */
+        void limit_wire_length();
+        /**
+         * Adds constraints to the solver to limit the number of crossing tiles to be used.
+         */
+        void limit_crossings();
+        /**
+         * Adds constraints to the solver to break translational symmetries of the clocking scheme. A placement whose
+         * tiles all lie at least one period of the clocking scheme away from the layout's western (northern) border
+         * can be shifted west (north) by that period without changing any clock zone. Therefore, only placements that
+         * occupy at least one tile within the first period in both directions need to be considered. Open clockings
+         * are invariant under shifts by one tile. Does not apply if I/Os are to be placed at the layout's borders
+         * because shifting moves them away from it.
+         */
+        void break_symmetries();
+        /**
+         * Collects the placement of each vertex on the tile it was placed on by the warm start in suggestions. They
+         * are passed to the solver as assumptions by check. Since a partial placement is hardly satisfiable, nothing is
+         * suggested unless the warm start's bounding box fits the layout.
+         */
+        void suggest_placement();
+        /**
+         * Checks the instance under the given assumptions. If placements were suggested and all of their tiles are
+         * active, the solver is guided towards them by assuming them as well first. Unlike soft constraints, which
+         * would turn each call into an optimization, this keeps the search a plain satisfiability check. If the
+         * suggestions turn out to be part of the reason for unsatisfiability or the guided call does not terminate,
+         * the instance is checked again without them so that no solution is excluded.
+         *
+         * @param assumptions Assumptions to check the instance under.
+         * @return Result of the solver call.
+         */
+        z3::check_result check(const z3::expr_vector& assumptions);
+        /**
+         * Generates the SMT instance and adds it to the solver.
+         */
+        void generate_smt_instance();
+    };
+
     /**
-     * Initializes vcl_map using netlist and context.
-     *
-     * Creates v many variables.
+     * Determines lower_bound as the maximum of several cheap bounds on the number of tiles and sets all the members
+     * that is derived from. These bounds are
+     *  - the number of vertices to be placed,
+     *  - the number of wire tiles needed to balance fan-in paths whose lengths differ by more than the clock zone
+     *    period can compensate for, where at most crossings_limit of them can be saved via crossings,
+     *  - the minimum layout that provides enough border tiles if border_io is set,
+     *  - the minimum layout that fits the critical path in case of monotone clocking schemes, which is 1 tile wide
+     *    unless a vertex branches, and
+     *  - infinity if there is a vertex with a fan-in or fan-out that no tile can provide under the clocking scheme.
      */
-    void initialize_vcl_map();
+    void determine_lower_bound() noexcept;
     /**
-     * Initializes tcl_map using layout and context.
-     *
-     * Creates t many variables.
+     * Runs orthogonal_pr to obtain placement_hints. If the resulting layout satisfies all constraints given by config,
+     * it is stored as warm_start_layout and upper_bound is set below its area so that only smaller layouts are
+     * searched for. Requires an AOIG and a 2DDWave clocking scheme.
      */
-    void initialize_tcl_map();
+    void warm_start();
     /**
-     * Initializes tl_map using layout and context.
+     * Checks whether the given layout satisfies the constraints given by config regarding crossings, wire lengths,
+     * border I/Os, and path balancing.
      *
-     * Creates t many variables
+     * @param fgl Layout to check.
+     * @return True iff fgl could have been found by the solver as well.
      */
-    void initialize_tl_map();
+    bool satisfies_config(const fcn_gate_layout& fgl) const noexcept;
     /**
-     * Workaround helper function for getting the variable from a tile_vertex_map
-     * corresponding to a given tile and vertex.
+     * Returns warm_start_layout as the result if there is one.
      *
-     * @param t tile to be considered.
-     * @param v vertex to be considered.
-     * @return First (and only) element from the vector in map found by the keys.
+     * @param log Statistical information about the exploration.
+     * @param exhausted Flag to indicate that all dimensions smaller than warm_start_layout were shown not to host a
+     *                  layout which makes it minimal.
+     * @return pr_result containing warm_start_layout if available.
      */
-    z3::expr get_tv(const layout_tile& t, const logic_vertex v);
+    pr_result fall_back(nlohmann::json&& log, const bool exhausted);
     /**
-     * Workaround helper function for getting the variable from a tile_edge_map
-     * corresponding to a given tile and edge.
+     * Appends a progress event about an explored dimension to progress_log and passes it to config.progress if set.
+     * Has to be called by one thread at a time.
      *
-     * @param t tile to be considered.
-     * @param e edge to be considered.
-     * @return First (and only) element from the vector in map found by the keys.
+     * @param dim Explored dimension.
+     * @param result Solver result for dim.
+     * @param statistics Solver statistics for dim.
+     * @param start Begin of the exploration.
      */
-    z3::expr get_te(const layout_tile& t, const logic_edge& e);
+    void report_progress(const fcn_dimension_xy& dim, const z3::check_result result, nlohmann::json&& statistics,
+                         const chrono::time_point start);
     /**
-     * Workaround helper function for getting the variable from a tile_connection_map
-     * corresponding to two given tiles.
+     * Checks whether the given dimension can possibly host a layout. Dimensions that provide too few border tiles
+     * for the I/Os or whose extents are too small to fit the critical path or a branching vertex under a monotone
+     * clocking scheme can be skipped without calling the solver.
      *
-     * @param t1 First tile to be considered.
-     * @param t2 Second tile to be considered.
-     * @return First (and only) element from the vector in map found by the keys.
+     * @param dim Dimension to check.
+     * @return True iff dim passes all checks.
      */
-    z3::expr get_tc(const layout_tile& t1, const layout_tile& t2);
+    bool is_viable(const fcn_dimension_xy& dim) const noexcept;
     /**
-     * Workaround helper function for getting the variable from a tile_path_map
-     * corresponding to two given tiles.
+     * Checks whether a layout that is 1 tile wide and smaller than the given area could possibly host the network.
+     * Such dimensions are never explored because factorize omits them. Hence, layouts of the given area cannot be
+     * claimed to be minimal in this case.
      *
-     * @param t1 First tile to be considered.
-     * @param t2 Second tile to be considered.
-     * @return First (and only) element from the vector in map found by the keys.
+     * @param area Area to compare to.
+     * @return True iff a viable dimension of extent 1 precedes area.
      */
-    z3::expr get_tp(const layout_tile& t1, const layout_tile& t2);
+    bool is_narrower_viable(const std::size_t area) const noexcept;
     /**
-     * Workaround helper function for getting the variable from a vertex_clock_map
-     * corresponding to a given vertex.
+     * Checks whether swapping x and y maps the clocking scheme onto itself. If it does, each solution for some
+     * dimension x * y can be transposed into one for y * x. Consequently, if x * y is unsatisfiable, so is y * x.
      *
-     * @param v vertex to be considered.
-     * @return First (and only) element from the vector in map found by the key.
+     * @return True iff the clocking scheme is invariant under transposition.
      */
-    z3::expr get_vcl(const logic_vertex v);
+    bool is_transposition_invariant() const noexcept;
     /**
-     * Workaround helper function for getting the variable from a tile_clock_map
-     * corresponding to a given tile.
+     * Determines the dimension of a layout that spans the given dimension and as many of the viable dimensions to be
+     * explored after it as possible without exceeding config.canvas_limit tiles. In incremental mode, an instance that
+     * is generated for it can represent all of those dimensions via tile activity assumptions.
      *
-     * @param t tile to be considered.
-     * @return First (and only) element from the vector in map found by the key.
+     * @param dim First dimension to be covered.
+     * @return Smallest dimension covering dim and its successors in the exploration order up to the limit.
      */
-    z3::expr get_tcl(const layout_tile& t);
+    fcn_dimension_xy bounding_canvas(const fcn_dimension_xy& dim) const noexcept;
     /**
-     * Workaround helper function for getting the variable from a tile_latch_map
-     * corresponding to a given tile.
+     * Explores all layout dimensions one after another using a single smt_handler. The first dimension that allows
+     * for a satisfiable instance is returned. If the timeout is reached before, the warm start layout is returned if
+     * available.
      *
-     * @param t tile to be considered.
-     * @return First (and only) element from the vector in map found by the key.
+     * @return pr_result containing placed and routed layout as well as some statistical information.
      */
-    z3::expr get_tl(const layout_tile& t);
+    pr_result explore_sequentially();
     /**
-     * Helper function for generating an equality of an arbitrary number of expressions.
+     * Explores layout dimensions concurrently using config.threads many workers. Each worker solves one dimension
+     * at a time in its own smt_handler. Dimensions are handed out in the same order the sequential exploration would
+     * visit them, i.e. all aspect ratios of an area and the following areas as long as workers are idle. As soon as
+     * a dimension turns out to be satisfiable, all solver calls on later dimensions are interrupted. Earlier ones are
+     * still awaited so that the returned layout is the same the sequential exploration would find. If the timeout
+     * prevents that, the smallest layout found so far is returned as a non-optimal result.
      *
-     * @param v Vector of expressions to equal.
-     * @return Expression that represents the equality of all elements in v.
-     */
-    z3::expr mk_eq(const z3::expr_vector& v) const noexcept;
-    /**
-     * Constructs a series of expressions to evaluate how many tiles were occupied by a
-     * given edge. Therefore, all te variables are translated to expressions like
-     * ite(te, 1, 0) which allows for applying z3::sum to them. This is a work around because
-     * no such api function for pseudo boolean exists.
-     *
-     * @param e edge to check for.
-     * @param ve Vector of expressions to extend.
-     */
-    void tile_ite_counters(const logic_edge& e, z3::expr_vector& ve) noexcept;
-    /**
-     * Adds constraints to the solver to limit the number of elements that are going to be
-     * assigned to a tile to one (vertex or edge) if no crossings are allowed.
-     * Otherwise, one vertex per tile or two edges per tile can be placed.
-     */
-    void restrict_tile_elements();
-    /**
-     * Adds constraints to the solver to enforce that each vertex is placed exactly once
-     * on exactly one tile.
-     */
-    void restrict_vertices();
-    /**
-     * Adds constraints to the solver to enforce that each clock zone variable has valid
-     * bounds of 0 <= cl <= 3.
-     */
-    void restrict_clocks();
-    /**
-     * Adds constraints to the solver to enforce that latches have to be positive, that vertex tiles cannot be latches,
-     * and that the overall sum of latch values should be minimized.
-     */
-    void restrict_latches();
-    /**
-     * Adds constraints to the solver to enforce that a tile which was assigned with some
-     * vertex has a successor which is assigned to the adjacent vertex or an outgoing
-     * edge.
-     */
-    void define_adjacent_vertex_tiles();
-    /**
-     * Adds constraints to the solver to enforce that a tile which was assigned with some
-     * vertex has a predecessor which is assigned to the inversely adjacent vertex or an
-     * ingoing edge.
-     */
-    void define_inv_adjacent_vertex_tiles();
-    /**
-     * Adds constraints to the solver to enforce that a tile which was assigned with some
-     * edge has a successor which is assigned to the adjacent vertex or another edge.
-     */
-    void define_adjacent_edge_tiles();
-    /**
-     * Adds constraints to the solver to enforce that a tile which was assigned with some
-     * edge has a predecessor which is assigned to the inversely adjacent vertex or another
-     * edge.
-     */
-    void define_inv_adjacent_edge_tiles();
-    /**
-     * Adds constraints to the solver to map so far established connections between single
-     * tiles to sub-paths. They are spanned transitively by the next set of constraints.
-     */
-    void establish_sub_paths();
-    /**
-     * Adds constraints to the solver to expand the formerly created sub-paths transitively.
-     */
-    void establish_transitive_paths();
-    /**
-     * Adds constraints to the solver to forbid cycles that loop back information. Therefore,
-     * the formerly established paths are used.
-     */
-    void eliminate_cycles();
-    /**
-     * Adds constraints to the solver to ensure that the cl variable of primary input pi
-     * is set to the clocking zone value of the tile pi is assigned to.
-     */
-    void assign_pi_clockings();
-    /**
-     * Adds constraints to the solver to ensure that fan-in paths to the same tile need
-     * to have the same length modulo timing.
-     */
-    void fanin_length();
-    /**
-     * Adds constraints to the solver to prevent edges or vertices to be assigned to tiles
-     * with an insufficient number of predecessors/successors.
-     */
-    void prevent_insufficiencies();
-    /**
-     * Adds constraints to the solver to define the exact number of connection variables to be set
-     * for each tile, i.e. empty tiles are not allowed to have connections at all, edges need to have
-     * one ingoing and one outgoing connection and so on.
-     */
-    void define_number_of_connections();
-    /**
-     * Adds constraints to the solver to position the primary inputs and primary outputs at
-     * the layout's borders.
-     */
-    void enforce_border_io();
-    /**
-     * Adds constraints to the solver to limit the number of wire elements that are allowed
-     * to be used to connect two vertices in the layout.
-     */
-    void limit_wire_length();
-    /**
-     * Adds constraints to the solver to limit the number of crossing tiles to be used.
-     */
-    void limit_crossings();
-    /**
-     * Generates the SMT instance and adds it to the solver.
-     */
-    void generate_smt_instance();
-    /**
-     * Assigns vertices, edges and directions to the stored layout with respect to the found model.
+     * @return pr_result containing placed and routed layout as well as some statistical information.
      */
-    void assign_layout();
+    pr_result explore_concurrently();
 };
 
 
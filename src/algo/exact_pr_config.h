@@ -8,7 +8,9 @@
 #include <string>
 #include <memory>
 #include <limits>
+#include <functional>
 #include "fcn_clocking_scheme.h"
+#include "nlohmann/json.hpp"
 
 /**
  * Default timeout defined by Z3.
@@ -56,6 +58,28 @@ struct exact_pr_config
      * Flag to indicate that artificial clock latch delays should be used to balance paths.
      */
     bool artificial_latch = false;
+    /**
+     * Flag to indicate that one SMT instance should be reused for several layout dimensions by activating tiles via
+     * assumptions instead of generating a new instance for each dimension.
+     */
+    bool incremental = false;
+    /**
+     * Maximum number of tiles of the layout that is encoded once in incremental mode to cover all dimensions to be
+     * explored next. Dimensions that do not fit into it lead to a new encoding. If value is 0, it is twice the area of
+     * the first dimension to be covered.
+     */
+    unsigned canvas_limit = 0u;
+    /**
+     * Flag to indicate that symmetries of the clocking scheme should be excluded from the search space. Placements
+     * that can be shifted towards the origin are prohibited and transposed dimensions of unsatisfiable ones are
+     * skipped if the clocking scheme allows for it.
+     */
+    bool symmetry_breaking = false;
+    /**
+     * Flag to indicate that orthogonal_pr should be run first. Its placement is suggested to the solver and, if it
+     * satisfies all other constraints, its area serves as an upper bound and its layout is returned on timeouts.
+     */
+    bool warm_start = false;
     /**
      * Clocking scheme to be used.
      */
@@ -64,6 +88,16 @@ struct exact_pr_config
      * Sets a timeout in ms for the solving process. Standard is 4294967295 as defined by Z3.
      */
     unsigned timeout = DEFAULT_TIMEOUT;
+    /**
+     * Number of threads to use for exploring layout dimensions concurrently. If value is 1, dimensions are explored
+     * sequentially. If value is 0, all available hardware threads are used.
+     */
+    unsigned threads = 1u;
+    /**
+     * Callback to report progress to. It is invoked with a JSON object holding area, dimension, elapsed time, result,
+     * and solver statistics each time a dimension was explored. Calls are never concurrent.
+     */
+    std::function<void(const nlohmann::json&)> progress = nullptr;
 
     /**
      * Default standard constructor.
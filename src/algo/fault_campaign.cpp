@@ -0,0 +1,245 @@
+//
+// fault_campaign.cpp
+//
+
+#include "fault_campaign.h"
+#include <unordered_map>
+#include <algorithm>
+#include <random>
+#include <chrono>
+#include <thread>
+#include <atomic>
+
+
+fault_campaign::fault_campaign(fcn_gate_layout_ptr fgl, const campaign_config& config)
+        :
+        layout{std::move(fgl)},
+        config{config},
+        network{std::make_shared<logic_network>(layout->get_name())}
+{
+    build_network();
+}
+
+std::size_t fault_campaign::num_sites() const noexcept
+{
+    return sites.size();
+}
+
+nlohmann::json fault_campaign::run()
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    const logic_network_simulator simulator{*network};
+
+    // simulate exhaustively if all input combinations fit into the requested number of patterns
+    const auto num_pis = simulator.num_pis();
+    const auto exhaustive = num_pis <= logic_network_simulator::MAX_EXHAUSTIVE_INPUTS &&
+                            (1ul << num_pis) <= config.patterns;
+    const auto num_patterns = exhaustive ? 1ul << num_pis : config.patterns;
+    const auto patterns = exhaustive ? logic_network_simulator::exhaustive_patterns(num_pis) :
+                          logic_network_simulator::random_patterns(num_pis, num_patterns, config.seed);
+
+    const auto golden = simulator.simulate(patterns, num_patterns);
+
+    // a layout without gates and wires does not offer any site to inject faults into
+    const auto num_configurations = sites.empty() ? 0ul : config.configurations;
+
+    const auto num_threads = static_cast<unsigned>(std::min(
+            static_cast<std::size_t>(config.threads ? config.threads : std::max(std::thread::hardware_concurrency(), 1u)),
+            std::max(num_configurations, 1ul)));
+
+    // each thread collects its own statistics that are merged afterwards
+    std::vector<std::vector<site_statistics>> thread_statistics(num_threads,
+                                                                std::vector<site_statistics>(sites.size()));
+    std::vector<std::size_t> thread_detected(num_threads, 0ul);
+    std::atomic<std::size_t> next{0ul};
+
+    const auto evaluate = [&](const unsigned _thread)
+    {
+        auto& statistics = thread_statistics[_thread];
+        std::vector<logic_network_simulator::fault> faults{};
+
+        for (std::size_t c; (c = next++) < num_configurations;)
+        {
+            const auto drawn = draw_faults(c);
+
+            faults.clear();
+            for (auto&& [s, f] : drawn)
+                faults.push_back(f);
+
+            const auto detected = simulator.simulate(patterns, num_patterns, faults) != golden;
+            if (detected)
+                ++thread_detected[_thread];
+
+            for (auto&& [s, f] : drawn)
+            {
+                ++statistics[s].injections;
+                ++(detected ? statistics[s].detections : statistics[s].masked);
+            }
+        }
+    };
+
+    std::vector<std::thread> workers{};
+    workers.reserve(num_threads);
+    for (unsigned i = 0u; i < num_threads; ++i)
+        workers.emplace_back(evaluate, i);
+    for (auto& w : workers)
+        w.join();
+
+    std::vector<site_statistics> statistics(sites.size());
+    for (auto&& ts : thread_statistics)
+    {
+        for (std::size_t s = 0ul; s < sites.size(); ++s)
+        {
+            statistics[s].injections += ts[s].injections;
+            statistics[s].detections += ts[s].detections;
+            statistics[s].masked     += ts[s].masked;
+        }
+    }
+
+    std::size_t detected = 0ul;
+    for (auto d : thread_detected)
+        detected += d;
+
+    nlohmann::json report{};
+    report["configurations"]         = num_configurations;
+    report["faultsPerConfiguration"] = std::min(config.faults, sites.size());
+    report["patterns"]               = num_patterns;
+    report["exhaustive"]             = exhaustive;
+    report["seed"]                   = config.seed;
+    report["threads"]                = num_threads;
+    report["detected"]               = detected;
+    report["masked"]                 = num_configurations - detected;
+
+    auto& site_report = report["sites"] = nlohmann::json::array();
+    for (std::size_t s = 0ul; s < sites.size(); ++s)
+    {
+        const auto& [t, gw, v] = sites[s];
+        const auto is_gate = std::holds_alternative<logic_network::vertex>(gw);
+
+        site_report.push_back({{"tile",       {t[X], t[Y], t[Z]}},
+                               {"type",       is_gate ? "gate" : "wire"},
+                               {"operation",  name_str(is_gate ? layout->get_op(t) : operation::W)},
+                               {"injections", statistics[s].injections},
+                               {"detections", statistics[s].detections},
+                               {"masked",     statistics[s].masked}});
+    }
+
+    report["runtime"] = std::chrono::duration<double>{std::chrono::steady_clock::now() - start}.count();
+
+    return report;
+}
+
+void fault_campaign::build_network()
+{
+    const auto ports = layout->get_network();
+
+    std::unordered_map<fcn_gate_layout::tile, logic_network::vertex, boost::hash<fcn_gate_layout::tile>> gates{};
+    std::unordered_map<std::pair<fcn_gate_layout::tile, logic_network::edge>, logic_network::vertex,
+                       boost::hash<std::pair<fcn_gate_layout::tile, logic_network::edge>>> wires{};
+    // PIs by port name such that tiles sharing an input signal are fed by the same PI vertex
+    std::unordered_map<std::string, logic_network::vertex> pis{};
+    const auto get_pi = [this, &pis](const std::string& _name)
+    {
+        if (auto it = pis.find(_name); it != pis.end())
+            return it->second;
+
+        return pis[_name] = network->create_pi(_name);
+    };
+
+    // create a vertex for each gate and wire segment
+    for (auto&& t : layout->tiles())
+    {
+        if (layout->is_free_tile(t))
+            continue;
+
+        if (auto lv = layout->get_logic_vertex(t))
+        {
+            const auto op = layout->get_op(t);
+
+            logic_network::vertex v;
+            if (op == operation::PI)
+                v = get_pi(ports->get_port_name(*lv));
+            else if (op == operation::PO)
+                v = network->create_po(ports->get_port_name(*lv));
+            else
+            {
+                v = network->create_logic_vertex(op);
+
+                // implicit PIs and POs are not located on tiles of their own and need to be added manually
+                if (layout->is_pi(t))
+                {
+                    if (const auto names = layout->get_inp_names(t); names.empty())
+                        network->create_edge(network->create_pi(""), v);
+                    else
+                    {
+                        for (const auto& n : names)
+                            network->create_edge(get_pi(n), v);
+                    }
+                }
+                if (layout->is_po(t))
+                {
+                    if (const auto names = layout->get_out_names(t); names.empty())
+                        network->create_po(v, "");
+                    else
+                    {
+                        for (const auto& n : names)
+                            network->create_po(v, n);
+                    }
+                }
+            }
+
+            gates.emplace(t, v);
+            sites.push_back({t, *lv, v});
+        }
+
+        for (auto&& e : layout->get_logic_edges(t))
+        {
+            const auto v = network->create_logic_vertex(operation::W);
+
+            wires.emplace(std::make_pair(t, e), v);
+            sites.push_back({t, e, v});
+        }
+    }
+
+    // connect them according to the layout's data flow
+    for (auto&& [t, gw, v] : sites)
+    {
+        for (auto&& [_t, _gw] : layout->incoming_data_flow(t, gw))
+        {
+            if (std::holds_alternative<logic_network::vertex>(_gw))
+            {
+                if (auto it = gates.find(_t); it != gates.end())
+                    network->create_edge(it->second, v);
+            }
+            else if (auto it = wires.find(std::make_pair(_t, std::get<logic_network::edge>(_gw))); it != wires.end())
+                network->create_edge(it->second, v);
+        }
+    }
+}
+
+std::vector<std::pair<std::size_t, logic_network_simulator::fault>>
+fault_campaign::draw_faults(const std::size_t c) const noexcept
+{
+    // seed each configuration individually to be independent of thread scheduling
+    std::seed_seq seq{static_cast<std::uint32_t>(config.seed), static_cast<std::uint32_t>(config.seed >> 32u),
+                      static_cast<std::uint32_t>(c), static_cast<std::uint32_t>(static_cast<std::uint64_t>(c) >> 32u)};
+    std::mt19937_64 rgen(seq);
+    std::uniform_int_distribution<std::size_t> site_dist(0ul, sites.size() - 1ul);
+    std::bernoulli_distribution value_dist{};
+
+    std::vector<std::pair<std::size_t, logic_network_simulator::fault>> drawn{};
+    const auto num_faults = std::min(config.faults, sites.size());
+    while (drawn.size() < num_faults)
+    {
+        const auto s = site_dist(rgen);
+        if (std::any_of(drawn.cbegin(), drawn.cend(), [s](const auto& _d){return _d.first == s;}))
+            continue;
+
+        // gates are stuck at a random value while broken wires do not propagate any signal
+        const auto is_gate = std::holds_alternative<logic_network::vertex>(sites[s].gw);
+        drawn.push_back({s, {sites[s].v, is_gate && value_dist(rgen)}});
+    }
+
+    return drawn;
+}
@@ -0,0 +1,164 @@
+//
+// fault_campaign.h
+//
+
+#ifndef FICTION_FAULT_CAMPAIGN_H
+#define FICTION_FAULT_CAMPAIGN_H
+
+#include "fcn_gate_layout.h"
+#include "logic_network.h"
+#include "logic_network_simulator.h"
+#include <nlohmann/json.hpp>
+#include <boost/functional/hash.hpp>
+#include <vector>
+#include <cstdint>
+
+
+/**
+ * Performs fault-injection campaigns on gate layouts to study their fault tolerance. A campaign consists of a number of
+ * fault configurations, each of which injects a few randomly chosen faults into the layout at once. The following fault
+ * types are considered.
+ *
+ *  - Stuck-at-0 and stuck-at-1 faults on gate tiles, i.e. the gate's output is fixed to a constant value.
+ *  - Broken wires on wire tiles. The signal of a broken wire segment does no longer propagate which is modeled by a
+ *    stuck-at-0 fault on the segment. Each wire segment on a tile, e.g. both segments of a crossing, is a fault site of
+ *    its own.
+ *
+ * To this end, a logic network with one vertex per gate and per wire segment of the layout is built on construction.
+ * Each configuration is evaluated by word-parallel fault simulation of that network (see logic_network_simulator) and
+ * compared to the fault-free simulation under the same patterns. A configuration is detected iff any PO differs under
+ * any pattern and masked otherwise.
+ *
+ * Configurations are distributed over a pool of threads. Since the random number generator of each configuration is
+ * seeded by the campaign's seed and the configuration's index, results do not depend on the number of threads or on
+ * their scheduling, i.e. the same seed always leads to the same report.
+ */
+class fault_campaign
+{
+public:
+    /**
+     * Parameters of a campaign.
+     */
+    struct campaign_config
+    {
+        /**
+         * Number of fault configurations to evaluate.
+         */
+        std::size_t configurations = 1000ul;
+        /**
+         * Number of faults injected at distinct sites per configuration. Limited by the number of fault sites.
+         */
+        std::size_t faults = 1ul;
+        /**
+         * Number of input patterns to simulate each configuration with. If all input combinations fit into that
+         * number, they are simulated exhaustively instead.
+         */
+        std::size_t patterns = 1024ul;
+        /**
+         * Seed of all random decisions.
+         */
+        std::uint64_t seed = 0ul;
+        /**
+         * Number of threads to evaluate configurations with (0 uses all available).
+         */
+        unsigned threads = 0u;
+    };
+    /**
+     * Standard constructor. Builds the network to inject faults into.
+     *
+     * @param fgl Gate layout to perform the campaign on.
+     * @param config Parameters of the campaign.
+     */
+    fault_campaign(fcn_gate_layout_ptr fgl, const campaign_config& config);
+    /**
+     * Default Destructor.
+     */
+    ~fault_campaign() = default;
+    /**
+     * Copy constructor is not available.
+     */
+    fault_campaign(const fault_campaign& rhs) = delete;
+    /**
+     * Move constructor is not available.
+     */
+    fault_campaign(fault_campaign&& rhs) = delete;
+    /**
+     * Assignment operator is not available.
+     */
+    fault_campaign& operator=(const fault_campaign& rhs) = delete;
+    /**
+     * Move assignment operator is not available.
+     */
+    fault_campaign& operator=(fault_campaign&& rhs) = delete;
+    /**
+     * Returns the number of fault sites, i.e. gates and wire segments, in the layout.
+     *
+     * @return Number of fault sites.
+     */
+    std::size_t num_sites() const noexcept;
+    /**
+     * Evaluates all fault configurations.
+     *
+     * @return A report containing the campaign's parameters, the numbers of detected and masked configurations, and
+     *         the injection, detection, and masking counts of each fault site.
+     */
+    nlohmann::json run();
+
+private:
+    /**
+     * Layout to inject faults into.
+     */
+    fcn_gate_layout_ptr layout;
+    /**
+     * Parameters of the campaign.
+     */
+    const campaign_config config;
+    /**
+     * A gate or wire segment of the layout that faults can be injected into.
+     */
+    struct fault_site
+    {
+        /**
+         * Tile the site is located on.
+         */
+        fcn_gate_layout::tile t;
+        /**
+         * Gate or wire segment on t.
+         */
+        fcn_gate_layout::gate_or_wire gw;
+        /**
+         * Vertex representing the site in network.
+         */
+        logic_network::vertex v;
+    };
+    /**
+     * All fault sites in the order of the layout's tiles.
+     */
+    std::vector<fault_site> sites{};
+    /**
+     * Network with one vertex per fault site plus ports of implicit PIs and POs.
+     */
+    logic_network_ptr network;
+    /**
+     * Injection, detection, and masking counts of a fault site.
+     */
+    struct site_statistics
+    {
+        std::size_t injections = 0ul, detections = 0ul, masked = 0ul;
+    };
+    /**
+     * Creates a vertex in network for each gate and wire segment of layout and connects them according to the layout's
+     * data flow.
+     */
+    void build_network();
+    /**
+     * Draws the faults of the given configuration.
+     *
+     * @param c Index of the configuration.
+     * @return Indices of the faulty sites together with the faults to inject.
+     */
+    std::vector<std::pair<std::size_t, logic_network_simulator::fault>> draw_faults(const std::size_t c) const noexcept;
+};
+
+
+#endif //FICTION_FAULT_CAMPAIGN_H
@@ -21,10 +21,12 @@ orthogonal_pr::pr_result orthogonal_pr::perform_place_and_route()
 
     auto start = chrono::now();
 
+    // take a compact snapshot of the network for the traversals
+    const logic_network_csr csr{*network, io_ports};
     // get joint DFS ordering
-    auto jDFS = jdfs_order();
+    auto jDFS = jdfs_order(csr);
     // compute a red-blue-coloring for the network
-    auto rbColoring = find_rb_coloring(jDFS);
+    auto rbColoring = find_rb_coloring(csr, jDFS);
 
     try
     {
@@ -39,83 +41,120 @@ orthogonal_pr::pr_result orthogonal_pr::perform_place_and_route()
     return pr_result{true, nlohmann::json{{"runtime", calc_runtime(start, chrono::now())}}};
 }
 
-orthogonal_pr::jdfs_ordering orthogonal_pr::jdfs_order() const
+orthogonal_pr::jdfs_ordering orthogonal_pr::jdfs_order(const logic_network_csr& csr) const
 {
     // stores the ordering
     jdfs_ordering ordering{};
-    // store discovery of nodes
-    std::unordered_map<logic_network::vertex, bool> discovered{};
-    // range of logic vertices
-    auto vertices = network->vertices(io_ports);
-    // initialize all vertices undiscovered
-    std::for_each(vertices.begin(), vertices.end(),
-                  [&discovered](const logic_network::vertex _v){discovered.emplace(_v, false);});
+    ordering.reserve(csr.vertex_count());
+    // store discovery of nodes; all vertices are undiscovered initially
+    std::vector<bool> discovered(csr.size(), false);
     // helper function to check is a given vertex has already been discovered
     const auto is_discovered = [&discovered](const logic_network::vertex _v){return discovered[_v];};
+    // explicit DFS stack holding vertices together with the position of their next successor to visit
+    std::vector<std::pair<logic_network::vertex, std::size_t>> stack{};
 
-    // joint depth first search
-    const std::function<void(const logic_network::vertex)>
-            jdfs = [&](const logic_network::vertex _v)
+    // discovers a vertex if all its predecessors are yet discovered
+    const auto discover = [&](const logic_network::vertex _v)
     {
-        // if all predecessors are yet discovered
-        if (auto iav = network->inv_adjacent_vertices(_v, io_ports); std::all_of(iav.begin(), iav.end(), is_discovered))
+        if (auto iav = csr.fan_in(_v); std::all_of(iav.begin(), iav.end(), is_discovered))
         {
             discovered[_v] = true;
             ordering.push_back(_v);
+            stack.emplace_back(_v, 0u);
+        }
+    };
+
+    // joint depth first search
+    const auto jdfs = [&](const logic_network::vertex _v)
+    {
+        discover(_v);
+
+        while (!stack.empty())
+        {
+            auto& [v, next] = stack.back();
+            if (next == csr.out_degree(v))
+            {
+                stack.pop_back();
+                continue;
+            }
 
-            for (auto&& av : network->adjacent_vertices(_v, io_ports) | iter::filterfalse(is_discovered))
-                jdfs(av);
+            // discover may push onto the stack, hence, fetch the successor before
+            const auto av = *(csr.fan_out(v).begin() + next++);
+            if (!discovered[av])
+                discover(av);
         }
     };
 
     // call joint dfs for each vertex without predecessors
-    for (auto&& root : network->vertices(io_ports) | iter::filter([this](const logic_network::vertex _v)
-                                                                  {return network->in_degree(_v, io_ports) == 0u;}))
-        jdfs(root);
+    for (auto&& root : csr.vertices())
+    {
+        if (csr.in_degree(root) == 0u)
+            jdfs(root);
+    }
 
     return ordering;
 }
 
-orthogonal_pr::red_blue_coloring orthogonal_pr::find_rb_coloring(const jdfs_ordering& jdfs) const noexcept
+orthogonal_pr::red_blue_coloring orthogonal_pr::find_rb_coloring(const logic_network_csr& csr,
+                                                                 const jdfs_ordering& jdfs) const noexcept
 {
-    red_blue_coloring rb_coloring{};
-
     const auto contrary = [](const rb_color _c){return _c == rb_color::RED ? rb_color::BLUE : rb_color::RED;};
 
-    // range of logic edges
-    auto edges = network->edges(io_ports);
-    // color all edges white initially
-    std::for_each(edges.begin(), edges.end(),
-                  [&rb_coloring](const logic_network::edge& _e){rb_coloring.emplace(_e, rb_color::WHITE);});
+    // color all edges white initially; colors are indexed by the snapshot's edge indices
+    std::vector<rb_color> colors(csr.edge_count(), rb_color::WHITE);
 
-    const std::function<void(const logic_network::edge&, const rb_color)>
-            apply = [&](const logic_network::edge& _e, const rb_color _c)
+    // frame of the explicit coloring stack: an edge, its color, and the position of its next neighboring edge to visit,
+    // where neighbors are the outgoing edges of the edge's source followed by the incoming edges of its target
+    struct color_frame
     {
-        if (rb_coloring[_e] != rb_color::WHITE)
+        logic_network_csr::edge_id e;
+        rb_color c;
+        std::size_t next;
+    };
+    std::vector<color_frame> stack{};
+
+    // colors a white edge and all white edges connected to it by the coloring constraints in depth first order
+    const auto apply = [&](const logic_network_csr::edge_id _e, const rb_color _c)
+    {
+        if (colors[_e] != rb_color::WHITE)
             return;
 
-        rb_coloring[_e] = _c;
+        colors[_e] = _c;
+        stack.push_back({_e, _c, 0u});
 
-        for (auto&& oe : network->out_edges(network->source(_e), io_ports))
+        while (!stack.empty())
         {
-            if (oe != _e)
-                apply(oe, contrary(_c));
-        }
+            auto& frame = stack.back();
+            const auto src = csr.source(frame.e), tgt = csr.target(frame.e);
+            const auto out_deg = csr.out_degree(src);
 
-        for (auto&& ie : network->in_edges(network->target(_e), io_ports))
-        {
-            if (ie != _e)
-                apply(ie, _c);
+            if (frame.next == out_deg + csr.in_degree(tgt))
+            {
+                stack.pop_back();
+                continue;
+            }
+
+            // outgoing edges of the same source get the contrary color, incoming edges of the same target the same
+            const auto pos = frame.next++;
+            const auto [ne, nc] = pos < out_deg ?
+                                  std::make_pair(*(csr.out_edges(src).begin() + pos), contrary(frame.c)) :
+                                  std::make_pair(*(csr.in_edges(tgt).begin() + (pos - out_deg)), frame.c);
+
+            if (ne != frame.e && colors[ne] == rb_color::WHITE)
+            {
+                colors[ne] = nc;
+                stack.push_back({ne, nc, 0u});
+            }
         }
     };
 
     for (auto&& v : jdfs | iter::reversed)
     {
-        auto ie = network->in_edges(v, io_ports);
+        auto ie = csr.in_edges(v);
         // if any ingoing edge is BLUE, color them all in BLUE, and RED otherwise
         auto color = std::any_of(ie.begin(), ie.end(),
-                                 [&rb_coloring](const logic_network::edge& _e)
-                                               {return rb_coloring[_e] == rb_color::BLUE;}) ?
+                                 [&colors](const logic_network_csr::edge_id _e)
+                                          {return colors[_e] == rb_color::BLUE;}) ?
                      rb_color::BLUE :
                      rb_color::RED;
 
@@ -123,16 +162,23 @@ orthogonal_pr::red_blue_coloring orthogonal_pr::find_rb_coloring(const jdfs_orde
             apply(e, color);
     }
 
+    // translate the coloring back to the edges of the stored logic network
+    red_blue_coloring rb_coloring{};
+    rb_coloring.reserve(colors.size());
+    for (logic_network_csr::edge_id e = 0u; e < colors.size(); ++e)
+        rb_coloring.emplace(csr.get_edge(e), colors[e]);
+
     return rb_coloring;
 }
 
 void orthogonal_pr::orthogonal_embedding(red_blue_coloring& rb_coloring, const jdfs_ordering& jdfs)
 {
     // create layout with x = v, y = v, where v is the number of vertices in the network
-    // therefore, the layout needs to be shrunk to fit in the end
+    // therefore, the layout needs to be shrunk to fit in the end; since grid coordinates are computed arithmetically
+    // and tiles are stored sparsely, memory only scales with the number of occupied tiles
     layout = std::make_shared<fcn_gate_layout>(fcn_dimension_xy{network->vertex_count(io_ports), network->vertex_count(io_ports)},
-                                               phases == 3 ? std::move(twoddwave_3_clocking) :
-                                                             std::move(twoddwave_4_clocking), network);
+                                               fcn_clocking_scheme{phases == 3 ? twoddwave_3_clocking :
+                                                                                 twoddwave_4_clocking}, network, true);
     // cache map storing information about where vertices were placed on the layout
     std::unordered_map<logic_network::vertex, fcn_gate_layout::tile> pos;
 
@@ -257,7 +303,8 @@ void orthogonal_pr::orthogonal_embedding(red_blue_coloring& rb_coloring, const j
         // operation has two predecessors
         else
         {
-            auto ep = network->in_edges(v, io_ports).begin();
+            auto in_e = network->in_edges(v, io_ports);
+            auto ep = in_e.begin();
             // incoming edge 1
             const auto e1 = *ep;
             ++ep;
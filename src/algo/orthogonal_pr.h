@@ -6,6 +6,7 @@
 #define FICTION_ORTHOGONAL_PR_H
 
 #include "place_route.h"
+#include "logic_network_csr.h"
 
 /**
  * A heuristic P&R approach based on orthogonal graph drawing. A slight modification of
@@ -93,18 +94,20 @@ private:
      * This traversing starts at a PI and performs DFS but will not visit nodes who have undiscovered predecessors.
      * This process is then repeated for each other PI as well. Eventually all nodes will have been visited.
      *
+     * @param csr CSR snapshot of the stored logic network.
      * @return Joint DFS ordering of the stored logic network.
      */
-    jdfs_ordering jdfs_order() const;
+    jdfs_ordering jdfs_order(const logic_network_csr& csr) const;
     /**
      * Computes a red blue coloring for the stored logic network. A red blue coloring is a mapping from
      * edges to either red or blue such that all ingoing edges to a vertex v have the same color
      * and all outgoing edges from a vertex v have different colors.
      *
+     * @param csr CSR snapshot of the stored logic network.
      * @param jdfs Joint DFS ordering of the stored logic network.
      * @return Red-blue-coloring for the logic network.
      */
-    red_blue_coloring find_rb_coloring(const jdfs_ordering& jdfs) const noexcept;
+    red_blue_coloring find_rb_coloring(const logic_network_csr& csr, const jdfs_ordering& jdfs) const noexcept;
     /**
      * Computes a placement and a routing for the stored logic network with respect to the given red-blue-coloring.
      * It is mapped to an adequate layout which is stored within the class.
@@ -0,0 +1,342 @@
+//
+// pipeline_simulator.cpp
+//
+
+#include "pipeline_simulator.h"
+#include <boost/functional/hash.hpp>
+#include <unordered_map>
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <chrono>
+
+
+pipeline_simulator::pipeline_simulator(fcn_gate_layout_ptr fgl, const std::size_t vectors, const std::uint64_t seed)
+        :
+        layout{std::move(fgl)},
+        num_clocks{std::max(layout->num_clocks(), fcn_clock::number{1u})},
+        stream_length{std::max((vectors + 63ul) / 64ul, 1ul)}
+{
+    build_nodes();
+
+    std::mt19937_64 rgen(seed);
+    inputs.assign(num_pis, std::vector<word>(stream_length, 0ul));
+    for (auto& in : inputs)
+    {
+        for (auto& w : in)
+            w = rgen();
+    }
+
+    // evaluate each vector without clocking
+    golden.assign(pos.size(), std::vector<word>(stream_length, 0ul));
+    std::vector<word> values(nodes.size(), 0ul);
+    boost::container::small_vector<word, 4> in{};
+    for (std::size_t i = 0ul; i < stream_length; ++i)
+    {
+        for (auto n : order)
+        {
+            in.clear();
+            for (auto p : nodes[n].preds)
+                in.push_back(values[p]);
+            for (auto pi : nodes[n].pis)
+                in.push_back(inputs[pi][i]);
+
+            values[n] = evaluate(nodes[n], in);
+        }
+
+        for (std::size_t j = 0ul; j < pos.size(); ++j)
+            golden[j][i] = values[pos[j].first];
+    }
+}
+
+nlohmann::json pipeline_simulator::simulate()
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    nlohmann::json report{};
+    report["vectors"] = stream_length * 64ul;
+    report["throughput"] = nullptr;
+    report["analyticalThroughput"] = layout->critical_path_length_and_throughput().second;
+
+    // holding each vector for longer than the longest path lasts is always sustained in valid layouts
+    for (std::size_t period = 1ul; period <= max_latency + 1ul; ++period)
+    {
+        const auto samples = stream(period);
+
+        // find the latency of each PO under which it shows the value of every vector
+        std::vector<std::optional<std::size_t>> latencies(pos.size());
+        for (std::size_t j = 0ul; j < pos.size(); ++j)
+        {
+            for (std::size_t m = 0ul; m <= max_latency && !latencies[j]; ++m)
+            {
+                bool matches = true;
+                for (std::size_t i = 0ul; i < stream_length && matches; ++i)
+                    matches = samples[j][i * period + m] == golden[j][i];
+
+                if (matches)
+                    latencies[j] = m;
+            }
+        }
+
+        if (std::any_of(latencies.cbegin(), latencies.cend(), [](const auto& _l){return !_l;}))
+            continue;
+
+        report["throughput"] = period;
+
+        auto& po_report = report["pos"] = nlohmann::json::array();
+        for (std::size_t j = 0ul; j < pos.size(); ++j)
+        {
+            // phases from the first phase a vector is applied in until the end of the PO's active phase
+            const auto phases = *latencies[j] * num_clocks + nodes[pos[j].first].zone + 1ul;
+            po_report.push_back({{"name",          pos[j].second},
+                                 {"latencyPhases", phases},
+                                 {"latencyCycles", (phases + num_clocks - 1ul) / num_clocks}});
+        }
+
+        break;
+    }
+
+    report["runtime"] = std::chrono::duration<double>{std::chrono::steady_clock::now() - start}.count();
+
+    return report;
+}
+
+void pipeline_simulator::build_nodes()
+{
+    std::vector<std::pair<fcn_gate_layout::tile, fcn_gate_layout::gate_or_wire>> elements{};
+    std::unordered_map<fcn_gate_layout::tile, std::size_t, boost::hash<fcn_gate_layout::tile>> gates{};
+    std::unordered_map<std::pair<fcn_gate_layout::tile, logic_network::edge>, std::size_t,
+                       boost::hash<std::pair<fcn_gate_layout::tile, logic_network::edge>>> wires{};
+    std::vector<std::pair<std::size_t, std::string>> pis{};
+
+    // create a node for each gate and wire segment
+    for (auto&& t : layout->tiles())
+    {
+        if (layout->is_free_tile(t))
+            continue;
+
+        const auto zone = layout->tile_clocking(t).value_or(0ul) % num_clocks;
+        const auto stall = layout->get_latch(t) / num_clocks;
+
+        if (auto v = layout->get_logic_vertex(t))
+        {
+            gates.emplace(t, nodes.size());
+
+            // implicit PIs and POs are not located on tiles of their own and a tile can host several of them
+            if (layout->is_pi(t))
+            {
+                if (const auto names = layout->get_inp_names(t); names.empty())
+                    pis.emplace_back(nodes.size(), "");
+                else
+                {
+                    for (const auto& n : names)
+                        pis.emplace_back(nodes.size(), n);
+                }
+            }
+            if (layout->is_po(t))
+            {
+                if (const auto names = layout->get_out_names(t); names.empty())
+                    pos.emplace_back(nodes.size(), "");
+                else
+                {
+                    for (const auto& n : names)
+                        pos.emplace_back(nodes.size(), n);
+                }
+            }
+
+            elements.emplace_back(t, *v);
+            nodes.push_back({layout->get_op(t), zone, stall});
+        }
+
+        for (auto&& e : layout->get_logic_edges(t))
+        {
+            wires.emplace(std::make_pair(t, e), nodes.size());
+
+            elements.emplace_back(t, e);
+            nodes.push_back({operation::W, zone, stall});
+        }
+    }
+
+    // order ports by their names like logic_network::foreach_pi and logic_network::foreach_po do
+    const auto by_name = [](const auto& _p1, const auto& _p2){return _p1.second < _p2.second;};
+    std::stable_sort(pis.begin(), pis.end(), by_name);
+    std::stable_sort(pos.begin(), pos.end(), by_name);
+
+    // one input stream per PI name that is shared by all nodes fed by it; unnamed PIs get a stream of their own
+    num_pis = 0ul;
+    for (std::size_t i = 0ul; i < pis.size(); ++i)
+    {
+        if (i == 0ul || pis[i].second.empty() || pis[i].second != pis[i - 1ul].second)
+            ++num_pis;
+
+        nodes[pis[i].first].pis.push_back(num_pis - 1ul);
+    }
+
+    // connect nodes according to the layout's data flow
+    std::vector<std::vector<std::size_t>> succs(nodes.size());
+    for (std::size_t n = 0ul; n < nodes.size(); ++n)
+    {
+        const auto& [t, gw] = elements[n];
+        for (auto&& [_t, _gw] : layout->incoming_data_flow(t, gw))
+        {
+            std::optional<std::size_t> p{};
+            if (std::holds_alternative<logic_network::vertex>(_gw))
+            {
+                if (auto it = gates.find(_t); it != gates.end())
+                    p = it->second;
+            }
+            else if (auto it = wires.find(std::make_pair(_t, std::get<logic_network::edge>(_gw))); it != wires.end())
+                p = it->second;
+
+            if (p)
+            {
+                nodes[n].preds.push_back(*p);
+                succs[*p].push_back(n);
+            }
+        }
+    }
+
+    // lay out the latched values of all nodes consecutively
+    zones.assign(num_clocks, {});
+    for (std::size_t n = 0ul, offset = 0ul; n < nodes.size(); ++n)
+    {
+        nodes[n].offset = offset;
+        offset += nodes[n].stall + 1ul;
+        zones[nodes[n].zone].push_back(n);
+    }
+
+    // topological order via Kahn's algorithm that also determines the longest path in clock phases
+    std::vector<std::size_t> pending(nodes.size()), phases(nodes.size(), 0ul), ready{};
+    for (std::size_t n = 0ul; n < nodes.size(); ++n)
+    {
+        pending[n] = nodes[n].preds.size();
+        if (pending[n] == 0ul)
+        {
+            ready.push_back(n);
+            phases[n] = nodes[n].zone + 1ul;
+        }
+    }
+
+    std::size_t longest = 0ul;
+    while (!ready.empty())
+    {
+        const auto n = ready.back();
+        ready.pop_back();
+        order.push_back(n);
+        longest = std::max(longest, phases[n]);
+
+        // values of n become visible to its successors after its latch delay
+        const auto delay = layout->get_latch(elements[n].first) + 1ul;
+        for (auto s : succs[n])
+        {
+            phases[s] = std::max(phases[s], phases[n] + delay);
+            if (--pending[s] == 0ul)
+                ready.push_back(s);
+        }
+    }
+
+    max_latency = longest / num_clocks + 1ul;
+}
+
+pipeline_simulator::word pipeline_simulator::evaluate(const sim_node& n,
+                                                      const boost::container::small_vector<word, 4>& in) const noexcept
+{
+    if (in.empty())
+        return n.op == operation::ONE ? ~0ul : 0ul;
+
+    switch (n.op)
+    {
+        case operation::AND:
+        {
+            return std::accumulate(in.cbegin(), in.cend(), ~0ul, [](const word _a, const word _b){return _a & _b;});
+        }
+        case operation::OR:
+        {
+            return std::accumulate(in.cbegin(), in.cend(), 0ul, [](const word _a, const word _b){return _a | _b;});
+        }
+        case operation::XOR:
+        {
+            return std::accumulate(in.cbegin(), in.cend(), 0ul, [](const word _a, const word _b){return _a ^ _b;});
+        }
+        case operation::NOT:
+        {
+            return ~in.back();
+        }
+        case operation::MAJ:
+        {
+            if (in.size() != 3ul)
+                return in.front();
+
+            return (in[0] & in[1]) | (in[0] & in[2]) | (in[1] & in[2]);
+        }
+        case operation::ONE:
+        {
+            return ~0ul;
+        }
+        case operation::ZERO:
+        case operation::NONE:
+        {
+            return 0ul;
+        }
+        default:  // F1O2, F1O3, W, BUF, PI, and PO forward their input signal
+        {
+            return in.back();
+        }
+    }
+}
+
+std::vector<std::vector<pipeline_simulator::word>> pipeline_simulator::stream(const std::size_t period) const noexcept
+{
+    const auto num_cycles = stream_length * period + max_latency + 1ul;
+
+    std::vector<std::vector<word>> samples(pos.size(), std::vector<word>(num_cycles, 0ul));
+
+    // the last stall + 1 values of each node and the position of the most recent one
+    std::vector<word> history(nodes.empty() ? 0ul : nodes.back().offset + nodes.back().stall + 1ul, 0ul);
+    std::vector<std::size_t> heads(nodes.size(), 0ul);
+    const auto latched = [&](const std::size_t _n)
+    {
+        const auto size = nodes[_n].stall + 1ul;
+        return history[nodes[_n].offset + (heads[_n] + size - nodes[_n].stall) % size];
+    };
+
+    std::vector<std::vector<std::size_t>> po_indices(nodes.size());
+    for (std::size_t j = 0ul; j < pos.size(); ++j)
+        po_indices[pos[j].first].push_back(j);
+
+    std::vector<word> updates{};
+    boost::container::small_vector<word, 4> in{};
+    for (std::size_t cycle = 0ul; cycle < num_cycles; ++cycle)
+    {
+        // the last vector is held after the stream has ended
+        const auto vector = std::min(cycle / period, stream_length - 1ul);
+
+        for (fcn_clock::zone z = 0ul; z < num_clocks; ++z)
+        {
+            // evaluate all nodes of the active zone before any of them latches its new value
+            updates.clear();
+            for (auto n : zones[z])
+            {
+                in.clear();
+                for (auto p : nodes[n].preds)
+                    in.push_back(latched(p));
+                for (auto pi : nodes[n].pis)
+                    in.push_back(inputs[pi][vector]);
+
+                updates.push_back(evaluate(nodes[n], in));
+            }
+
+            for (std::size_t u = 0ul; u < updates.size(); ++u)
+            {
+                const auto n = zones[z][u];
+                heads[n] = (heads[n] + 1ul) % (nodes[n].stall + 1ul);
+                history[nodes[n].offset + heads[n]] = updates[u];
+
+                for (auto j : po_indices[n])
+                    samples[j][cycle] = updates[u];
+            }
+        }
+    }
+
+    return samples;
+}
@@ -0,0 +1,178 @@
+//
+// pipeline_simulator.h
+//
+
+#ifndef FICTION_PIPELINE_SIMULATOR_H
+#define FICTION_PIPELINE_SIMULATOR_H
+
+#include "fcn_gate_layout.h"
+#include "logic_network.h"
+#include <nlohmann/json.hpp>
+#include <boost/container/small_vector.hpp>
+#include <vector>
+#include <optional>
+#include <string>
+#include <cstdint>
+
+
+/**
+ * A clock-phase-accurate simulator for gate layouts. Unlike fcn_gate_layout::critical_path_length_and_throughput, which
+ * derives the throughput analytically from path delay differences, this simulator streams input vectors through the
+ * layout and observes its POs to measure the sustained throughput and the latency of each PO.
+ *
+ * Every gate and every wire segment is a node that is clocked by the zone of its tile. The simulation advances phase
+ * by phase. In each phase, all nodes of the active zone re-evaluate their operation on the values their predecessors
+ * have latched before. A latch delay of l phases on a tile postpones the visibility of the tile's values to its
+ * successors by l phases. Thereby, successors of a tile read exactly the value that has been computed l + 1 phases
+ * before, even if l exceeds a clock cycle. PI tiles read the input vector that is currently applied.
+ *
+ * For a period of k clock cycles, a new input vector is applied every k cycles. The layout sustains period k iff each PO
+ * shows the value of every vector under a fixed latency, i.e. if no signals of consecutive vectors get mixed up on the
+ * way. Periods are tried in ascending order and the first sustained one is reported as throughput 1/k. The value of
+ * each vector is determined by evaluating the layout's gates and wires without clocking.
+ *
+ * Each bit of a 64-bit word represents an independent input stream, i.e. 64 streams are simulated at once and the
+ * requested number of vectors is split among them.
+ */
+class pipeline_simulator
+{
+public:
+    /**
+     * Word holding the values of 64 independent input streams.
+     */
+    using word = std::uint64_t;
+    /**
+     * Standard constructor. Prepares the simulation of the given layout.
+     *
+     * @param fgl Gate layout to simulate.
+     * @param vectors Number of input vectors to stream through the layout. Rounded up to a multiple of 64.
+     * @param seed Seed of the random input vectors.
+     */
+    pipeline_simulator(fcn_gate_layout_ptr fgl, const std::size_t vectors = 1024ul, const std::uint64_t seed = 0ul);
+    /**
+     * Default Destructor.
+     */
+    ~pipeline_simulator() = default;
+    /**
+     * Copy constructor is not available.
+     */
+    pipeline_simulator(const pipeline_simulator& rhs) = delete;
+    /**
+     * Move constructor is not available.
+     */
+    pipeline_simulator(pipeline_simulator&& rhs) = delete;
+    /**
+     * Assignment operator is not available.
+     */
+    pipeline_simulator& operator=(const pipeline_simulator& rhs) = delete;
+    /**
+     * Move assignment operator is not available.
+     */
+    pipeline_simulator& operator=(pipeline_simulator&& rhs) = delete;
+    /**
+     * Measures the sustained throughput of the layout and the latency of each PO.
+     *
+     * @return A report containing the measured throughput (1/x where only x is given or null if no period is sustained),
+     *         the analytical throughput for comparison, and the latency of each PO in clock phases and clock cycles.
+     */
+    nlohmann::json simulate();
+
+private:
+    /**
+     * Layout to simulate.
+     */
+    fcn_gate_layout_ptr layout;
+    /**
+     * Number of clocks of the layout.
+     */
+    const fcn_clock::number num_clocks;
+    /**
+     * Number of words per input stream, i.e. number of vectors per stream.
+     */
+    const std::size_t stream_length;
+    /**
+     * A gate or wire segment of the layout.
+     */
+    struct sim_node
+    {
+        /**
+         * Operation evaluated by the node.
+         */
+        operation op;
+        /**
+         * Clock zone of the node's tile.
+         */
+        fcn_clock::zone zone;
+        /**
+         * Number of full clock cycles the node's latch stalls its values by, i.e. how many of its values are held back.
+         */
+        std::size_t stall;
+        /**
+         * Nodes with data flow into this one in the order of fcn_gate_layout::incoming_data_flow.
+         */
+        boost::container::small_vector<std::size_t, 3> preds{};
+        /**
+         * Indices of the PIs whose input vectors are fed to the node if it is located on a PI tile.
+         */
+        boost::container::small_vector<std::size_t, 1> pis{};
+        /**
+         * First position of the node's latched values in history.
+         */
+        std::size_t offset = 0ul;
+    };
+    /**
+     * All nodes of the layout.
+     */
+    std::vector<sim_node> nodes{};
+    /**
+     * Nodes in topological order. Nodes on data flow cycles are excluded.
+     */
+    std::vector<std::size_t> order{};
+    /**
+     * Nodes clocked by each zone.
+     */
+    std::vector<std::vector<std::size_t>> zones{};
+    /**
+     * Nodes located on PO tiles and their respective port names ordered by the latter. A node appears once per port
+     * name of its tile.
+     */
+    std::vector<std::pair<std::size_t, std::string>> pos{};
+    /**
+     * Number of PIs.
+     */
+    std::size_t num_pis = 0ul;
+    /**
+     * Random input streams, one word per vector for each PI.
+     */
+    std::vector<std::vector<word>> inputs{};
+    /**
+     * Values of all POs for each vector evaluated without clocking.
+     */
+    std::vector<std::vector<word>> golden{};
+    /**
+     * Upper bound for the latency of any PO in clock cycles.
+     */
+    std::size_t max_latency = 0ul;
+    /**
+     * Creates nodes for all gates and wire segments of layout and connects them according to the layout's data flow.
+     */
+    void build_nodes();
+    /**
+     * Evaluates the operation of node n on the given input values.
+     *
+     * @param n Node to evaluate.
+     * @param in Values of n's predecessors followed by its PI value if it has one.
+     * @return Output value of n.
+     */
+    word evaluate(const sim_node& n, const boost::container::small_vector<word, 4>& in) const noexcept;
+    /**
+     * Streams all vectors through the layout applying a new one every period clock cycles.
+     *
+     * @param period Number of clock cycles each input vector is applied for.
+     * @return Value of each PO after its clock zone was active in each simulated clock cycle.
+     */
+    std::vector<std::vector<word>> stream(const std::size_t period) const noexcept;
+};
+
+
+#endif //FICTION_PIPELINE_SIMULATOR_H
@@ -13,6 +13,8 @@
 #include "fcn_cell_layout.h"
 #include "qca_one_library.h"
 #include "equivalence_checker.h"
+#include "fault_campaign.h"
+#include "pipeline_simulator.h"
 #include "json_parser.h"
 #include "json_writer.h"
 #include "qca_writer.h"
@@ -20,6 +22,9 @@
 #include <boost/range/iterator_range.hpp>
 #include <alice/alice.hpp>
 #include <mockturtle/io/verilog_reader.hpp>
+#include <thread>
+#include <atomic>
+#include <memory>
 
 namespace alice
 {
@@ -82,7 +87,9 @@ namespace alice
             add_option("filename", filename,
                        "Verilog or JSON filename or directory of Verilog or JSON files")->required();
             add_flag("--sort,-s", sort,
-                       "Sort files in given directory by file size prior to parsing");
+                       "Sort files in given directory by file size instead of by name prior to parsing");
+            add_option("--threads,-j", threads,
+                       "Number of threads to parse files in parallel (0 uses all available)", true);
         }
 
     protected:
@@ -129,78 +136,164 @@ namespace alice
             else // path leads nowhere
                 env->out() << "[e] given file name does not exist" << std::endl;
 
-            // sort by file size to make the small ones go first
+            // sort by name or by file size to make the small ones go first; either way, objects are inserted into
+            // the stores in a deterministic order independent of the number of threads
             if (sort)
             {
-                std::sort(paths.begin(), paths.end(), [](std::string& f1, std::string& f2)
-                { return boost::filesystem::file_size(f1) >= boost::filesystem::file_size(f2); });
+                std::sort(paths.begin(), paths.end(), [](const std::string& f1, const std::string& f2)
+                {
+                    const auto s1 = boost::filesystem::file_size(f1), s2 = boost::filesystem::file_size(f2);
+                    return s1 != s2 ? s1 < s2 : f1 < f2;
+                });
             }
+            else
+                std::sort(paths.begin(), paths.end());
 
-            // handle collected files
-            for (const auto& f : paths)
+            // parse collected files
+            std::vector<parse_result> results(paths.size());
+            const auto num_threads = std::min(static_cast<std::size_t>(threads ? threads :
+                                              std::max(std::thread::hardware_concurrency(), 1u)), paths.size());
+
+            if (num_threads <= 1u)
             {
-                // parse Verilog
-                if (boost::filesystem::extension(f) == ".v")
-                {
-                    read_verilog(f);
-                }
-                // parse ...
-                // else if (boost::filesystem::extension(f) == ...)
-                else if(boost::filesystem::extension(f) == ".json")
+                for (auto i = 0ul; i < paths.size(); ++i)
+                    results[i] = parse(paths[i]);
+            }
+            else
+            {
+                // workers fetch file indices one after another so that large files do not block the remaining ones
+                std::atomic<std::size_t> next{0ul};
+                const auto work = [this, &next, &results]()
                 {
-                    //std::cout << "Trying to read JSON" << std::endl;
-                    read_json(f);
-                }
+                    for (auto i = next++; i < paths.size(); i = next++)
+                        results[i] = parse(paths[i]);
+                };
+
+                std::vector<std::thread> workers{};
+                workers.reserve(num_threads);
+                for (auto i = 0ul; i < num_threads; ++i)
+                    workers.emplace_back(work);
+
+                for (auto& w : workers)
+                    w.join();
+            }
+
+            // handle parsed files in order
+            for (auto i = 0ul; i < paths.size(); ++i)
+            {
+                auto& r = results[i];
+
+                if (!r.error.empty())
+                    env->out() << "[e] " << r.error << std::endl;
+
+                if (r.ln)
+                    store<logic_network_ptr>().extend() = r.ln;
+
+                if (r.json)
+                    store<fcn_gate_layout_ptr>().extend() = r.fgl;
             }
 
             // reset flags, necessary for some reason... alice bug?
             paths = {};
             sort = false;
+            threads = 1u;
         }
 
     private:
+        /**
+         * Outcome of parsing a single file.
+         */
+        struct parse_result
+        {
+            /**
+             * Created logic network. nullptr if it could not be created.
+             */
+            logic_network_ptr ln = nullptr;
+            /**
+             * Created gate layout. Only set if a JSON file was parsed.
+             */
+            fcn_gate_layout_ptr fgl = nullptr;
+            /**
+             * Flag to indicate that a JSON file was parsed which leads to a gate layout store entry.
+             */
+            bool json = false;
+            /**
+             * Error message. Empty if parsing succeeded.
+             */
+            std::string error{};
+        };
+        /**
+         * Parses the given file according to its extension. Does not access any store so that it can be called by
+         * multiple threads concurrently. Since an exception escaping a worker thread would terminate the whole
+         * program, all of them are caught and reported as an error of the file at hand.
+         *
+         * @param f Path to the file to read.
+         * @return Parsed objects and error message.
+         */
+        parse_result parse(const std::string& f) const
+        {
+            try
+            {
+                // parse Verilog
+                if (boost::filesystem::extension(f) == ".v")
+                    return read_verilog(f);
+                // parse ...
+                // else if (boost::filesystem::extension(f) == ...)
+                else if (boost::filesystem::extension(f) == ".json")
+                    return read_json(f);
+            }
+            catch (const std::exception& e)
+            {
+                return parse_result{nullptr, nullptr, false, "error while parsing " + f + ": " + e.what()};
+            }
+            catch (...)
+            {
+                return parse_result{nullptr, nullptr, false, "unknown error while parsing " + f};
+            }
+
+            return parse_result{};
+        }
         /**
          * Handles creation of a logic_network object from the given Verilog file.
          *
          * @param f Path to the Verilog file to read
+         * @return Parsed logic network or error message.
          */
-        void read_verilog(std::string f)
+        parse_result read_verilog(const std::string& f) const
         {
             auto name = boost::filesystem::path{f}.stem().string();
-                    logic_network ln{std::move(name)};
+            logic_network ln{std::move(name)};
 
-                    if (lorina::diagnostic_engine diag{};
-                        lorina::read_verilog(f, mockturtle::verilog_reader{ln}, &diag) == lorina::return_code::success)
-                    {
-                        ln.substitute();
-                        store<logic_network_ptr>().extend() = std::make_shared<logic_network>(std::move(ln));
-                    }
-                    else
-                    {
-                        env->out() << "[e] parsing error in " << f << std::endl;
-                    }
+            if (lorina::diagnostic_engine diag{};
+                lorina::read_verilog(f, mockturtle::verilog_reader{ln}, &diag) == lorina::return_code::success)
+            {
+                ln.substitute();
+                return parse_result{std::make_shared<logic_network>(std::move(ln)), nullptr, false, ""};
+            }
+
+            return parse_result{nullptr, nullptr, false, "parsing error in " + f};
         }
         /**
          * Handles creation of logic_network and fcn_gate_layout objects from the given JSON file.
          *
          * @param f Path to the JSON file to read
+         * @return Parsed logic network and gate layout as well as an error message.
          */
-        void read_json(std::string f)
+        parse_result read_json(const std::string& f) const
         {
             auto name = boost::filesystem::path{f}.stem().string();
-            auto ln = std::make_shared<logic_network>(std::move(name));
-            std::shared_ptr<fcn_gate_layout> fgl;
-            std::shared_ptr<fcn_gate_library> fglib;
-            try {
-                json_parser parser(f, ln, fgl);
+            parse_result r{std::make_shared<logic_network>(std::move(name)), nullptr, true, ""};
+            try
+            {
+                json_parser parser(f, r.ln, r.fgl);
                 parser.parse();
-            } catch (const std::invalid_argument &ex) {
-                std::cout << "[e] " << ex.what() << std::endl;
+            }
+            catch (const std::invalid_argument& ex)
+            {
+                r.error = ex.what();
             }
 
-            store<logic_network_ptr>().extend() = ln;
-
-            store<fcn_gate_layout_ptr>().extend() = fgl;
+            return r;
         }
         /**
          * Verilog filename.
@@ -213,7 +306,11 @@ namespace alice
         /**
          * Flag to indicate that files should be sorted by file size.
          */
-         bool sort = false;
+        bool sort = false;
+        /**
+         * Number of threads used for parsing.
+         */
+        unsigned threads = 1u;
     };
 
     ALICE_ADD_COMMAND(read, "I/O")
@@ -303,6 +400,10 @@ namespace alice
                        "Maximum number of wire elements per connection");
             add_option("--timeout,-t", config.timeout,
                        "Timeout in milliseconds");
+            add_option("--threads,-j", config.threads,
+                       "Number of threads to explore layout dimensions in parallel (0 uses all available)", true);
+            add_option("--canvas_limit", config.canvas_limit,
+                       "Maximum number of tiles to encode at once in incremental mode (0 doubles the first area)");
 
             add_flag("--crossings,-x", config.crossings,
                      "Enable second layer for wire crossings");
@@ -316,6 +417,14 @@ namespace alice
                      "Allow clocked latch delays to balance fan-in paths");
             add_flag("--fixed_size,-f", config.fixed_size,
                      "Execute only one run with upper_bound given as a fixed size");
+            add_flag("--incremental,-n", config.incremental,
+                     "Reuse the SMT instance across layout dimensions");
+            add_flag("--symmetry_breaking,-y", config.symmetry_breaking,
+                     "Exclude placements and dimensions that are symmetric under the clocking scheme");
+            add_flag("--warm_start,-r", config.warm_start,
+                     "Run ortho first and use its layout as a hint, an upper bound, and a fallback on timeouts");
+            add_flag("--verbose,-v",
+                     "Print progress information for each explored layout dimension");
         }
 
     protected:
@@ -354,13 +463,25 @@ namespace alice
                 return;
             }
 
+            if (this->is_set("verbose"))
+                config.progress = [this](const nlohmann::json& _p){env->out() << "[i] " << _p.dump() << std::endl;};
+
             // perform exact P&R
             exact_pr pr{s.current(), std::move(config)};
 
-            if (auto result = pr.perform_place_and_route(); result.success)
+            auto result = pr.perform_place_and_route();
+
+            if (auto ws = result.json.find("warm_start"); ws != result.json.end() && ws->count("reason"))
+                env->out() << "[w] " << (*ws)["reason"].get<std::string>() << std::endl;
+
+            if (result.success)
             {
                 store<fcn_gate_layout_ptr>().extend() = pr.get_layout();
                 pr_result = result.json;
+
+                if (!result.json["optimal"].get<bool>())
+                    env->out() << "[w] not all smaller dimensions could be explored, the resulting layout is not "
+                                  "guaranteed to be minimal" << std::endl;
             }
             else
                 env->out() << "[e] impossible to place and route " << s.current()->get_name() << " within the given "
@@ -521,6 +642,12 @@ namespace alice
         {
             add_option("--wire_limit,-w", wire_limit,
                        "Maximum number of wires allowed per tile", true);
+            add_flag("--quiet,-q", quiet,
+                     "Do not print a summary but only generate the report to be logged");
+            add_option("--threads,-j", threads,
+                       "Number of threads to check row bands of the layout with (0 uses all available)", true);
+            add_flag("--incremental,-i", incremental,
+                     "Only re-check tiles that changed since the last incremental check of the same layout");
         }
 
     protected:
@@ -539,8 +666,24 @@ namespace alice
                 return;
             }
 
-            design_checker c{s.current(), std::move(wire_limit)};
-            report = c.check(env->out());
+            // keep the checker of an incremental check to observe changes until the next one
+            if (!incremental || !checker || checked_layout != s.current() || checked_wire_limit != wire_limit ||
+                checked_threads != threads)
+            {
+                checker.reset();
+                checker = std::make_unique<design_checker>(s.current(), wire_limit, threads, incremental);
+                checked_layout = s.current();
+                checked_wire_limit = wire_limit;
+                checked_threads = threads;
+            }
+
+            report = checker->check(env->out(), quiet);
+
+            if (!incremental)
+            {
+                checker.reset();
+                checked_layout.reset();
+            }
 
             reset_flags();
         }
@@ -561,6 +704,9 @@ namespace alice
         void reset_flags()
         {
             wire_limit = 1;
+            quiet = false;
+            threads = 1u;
+            incremental = false;
         }
 
     private:
@@ -572,6 +718,28 @@ namespace alice
          * Maximum number of wires per tile.
          */
         std::size_t wire_limit = 1;
+        /**
+         * Flag to indicate that no summary should be printed.
+         */
+        bool quiet = false;
+        /**
+         * Number of threads to check row bands with.
+         */
+        unsigned threads = 1u;
+        /**
+         * Flag to indicate that only changed tiles should be re-checked.
+         */
+        bool incremental = false;
+        /**
+         * Checker of the last incremental check that keeps observing its layout.
+         */
+        std::unique_ptr<design_checker> checker{};
+        /**
+         * Layout, wire limit, and number of threads of the last incremental check.
+         */
+        fcn_gate_layout_ptr checked_layout{};
+        std::size_t checked_wire_limit = 1;
+        unsigned checked_threads = 1u;
     };
 
     ALICE_ADD_COMMAND(check, "Verification")
@@ -890,6 +1058,8 @@ namespace alice
                        "Gate layout to compare the current one against", false);
             add_option("--faults,-f", faults,
                        "Maximum number of faults to randomly insert into the circuit", true);
+            add_option("--threads,-j", threads,
+                       "Number of threads to check output cones in parallel (0 uses all available)", true);
         }
 
     protected:
@@ -932,7 +1102,7 @@ namespace alice
                 }
 
                 // create comparator
-                equivalence_checker nc{fgl1, fgl2, faults};
+                equivalence_checker nc{fgl1, fgl2, faults, threads};
                 // and perform equivalence check
                 try
                 {
@@ -946,7 +1116,7 @@ namespace alice
             }
             else
             {
-                equivalence_checker nc{fgl1, faults};
+                equivalence_checker nc{fgl1, faults, threads};
                 result = nc.check();
             }
 
@@ -958,6 +1128,7 @@ namespace alice
             // reset index for future calls
             gli = -1;
             faults = 0;
+            threads = 1u;
         }
 
         /**
@@ -979,6 +1150,10 @@ namespace alice
          * Number of faults to be inserted.
          */
         std::size_t faults = 0;
+        /**
+         * Number of threads to check output cones with.
+         */
+        unsigned threads = 1u;
         /**
          * Gate layout pointers for comparison of logic networks.
          */
@@ -990,6 +1165,192 @@ namespace alice
     };
 
     ALICE_ADD_COMMAND(equiv, "Verification")
+
+
+    /**
+     * Performs a fault-injection campaign on the current gate layout. Faults are stuck-at faults on gates and broken
+     * wires. See fault_campaign.h for more details.
+     */
+    class faults_command : public command
+    {
+    public:
+        /**
+         * Standard constructor. Adds descriptive information, options, and flags.
+         *
+         * @param env alice::environment that specifies stores etc.
+         */
+        explicit faults_command(const environment::ptr& env)
+                :
+                command(env, "Injects a number of seeded fault configurations into the current gate layout and "
+                             "evaluates them by fault simulation. Gates can be stuck at 0 or 1 and wires can be "
+                             "broken. Detection and masking statistics of each fault site can be logged.")
+        {
+            add_option("--configurations,-c", config.configurations,
+                       "Number of fault configurations to evaluate", true);
+            add_option("--faults,-n", config.faults,
+                       "Number of faults per configuration", true);
+            add_option("--patterns,-p", config.patterns,
+                       "Number of input patterns to simulate each configuration with", true);
+            add_option("--seed,-s", config.seed,
+                       "Seed of the random fault selection and input patterns", true);
+            add_option("--threads,-j", config.threads,
+                       "Number of threads to evaluate configurations with (0 uses all available)", true);
+        }
+
+    protected:
+        /**
+         * Function to perform the fault-injection campaign. Generates a report and prints a summary.
+         */
+        void execute() override
+        {
+            auto& s = store<fcn_gate_layout_ptr>();
+
+            // error case: empty gate layout store
+            if (s.empty())
+            {
+                env->out() << "[w] no gate layout in store" << std::endl;
+                reset_flags();
+                return;
+            }
+
+            fault_campaign campaign{s.current(), config};
+            report = campaign.run();
+
+            const std::size_t configurations = report["configurations"], detected = report["detected"];
+            env->out() << fmt::format("[i] {} of {} fault configurations were detected, {} were masked",
+                                      detected, configurations, configurations - detected) << std::endl;
+
+            reset_flags();
+        }
+
+        /**
+         * Logs the resulting information in a log file.
+         *
+         * @return JSON object containing information about the fault-injection campaign.
+         */
+        nlohmann::json log() const override
+        {
+            return report;
+        }
+
+        /**
+         * Reset all flags. Necessary for some reason... alice bug?
+         */
+        void reset_flags()
+        {
+            config = fault_campaign::campaign_config{};
+        }
+
+    private:
+        /**
+         * Resulting logging information.
+         */
+        nlohmann::json report;
+        /**
+         * Parameters of the campaign.
+         */
+        fault_campaign::campaign_config config{};
+    };
+
+    ALICE_ADD_COMMAND(faults, "Verification")
+
+
+    /**
+     * Streams input vectors through the current gate layout clock phase by clock phase to measure its sustained
+     * throughput and the latency of each PO. See pipeline_simulator.h for more details.
+     */
+    class pipeline_command : public command
+    {
+    public:
+        /**
+         * Standard constructor. Adds descriptive information, options, and flags.
+         *
+         * @param env alice::environment that specifies stores etc.
+         */
+        explicit pipeline_command(const environment::ptr& env)
+                :
+                command(env, "Simulates the current gate layout clock phase by clock phase while applying a new input "
+                             "vector every few clock cycles. Measures the sustained throughput and the latency of "
+                             "each PO. Latencies can be logged.")
+        {
+            add_option("--vectors,-v", vectors,
+                       "Number of random input vectors to stream through the layout", true);
+            add_option("--seed,-s", seed,
+                       "Seed of the random input vectors", true);
+        }
+
+    protected:
+        /**
+         * Function to perform the pipelined simulation. Generates a report and prints a summary.
+         */
+        void execute() override
+        {
+            auto& s = store<fcn_gate_layout_ptr>();
+
+            // error case: empty gate layout store
+            if (s.empty())
+            {
+                env->out() << "[w] no gate layout in store" << std::endl;
+                reset_flags();
+                return;
+            }
+
+            pipeline_simulator simulator{s.current(), vectors, seed};
+            report = simulator.simulate();
+
+            if (report["throughput"].is_null())
+                env->out() << "[w] no throughput could be sustained" << std::endl;
+            else
+            {
+                const std::size_t tp = report["throughput"], atp = report["analyticalThroughput"];
+                env->out() << fmt::format("[i] sustained throughput: 1/{} (analytical: 1/{})", tp, atp) << std::endl;
+
+                for (auto&& po : report["pos"])
+                {
+                    env->out() << fmt::format("[i] latency of {}: {} clock cycles ({} phases)",
+                                              po["name"].get<std::string>(), po["latencyCycles"].get<std::size_t>(),
+                                              po["latencyPhases"].get<std::size_t>()) << std::endl;
+                }
+            }
+
+            reset_flags();
+        }
+
+        /**
+         * Logs the resulting information in a log file.
+         *
+         * @return JSON object containing information about the pipelined simulation.
+         */
+        nlohmann::json log() const override
+        {
+            return report;
+        }
+
+        /**
+         * Reset all flags. Necessary for some reason... alice bug?
+         */
+        void reset_flags()
+        {
+            vectors = 1024ul;
+            seed = 0ul;
+        }
+
+    private:
+        /**
+         * Resulting logging information.
+         */
+        nlohmann::json report;
+        /**
+         * Number of input vectors to stream.
+         */
+        std::size_t vectors = 1024ul;
+        /**
+         * Seed of the input vectors.
+         */
+        std::uint64_t seed = 0ul;
+    };
+
+    ALICE_ADD_COMMAND(pipeline, "Verification")
 }
 
 
@@ -3,21 +3,25 @@
 //
 
 #include "fcn_cell_layout.h"
+#include <algorithm>
+#include <stdexcept>
 
 
 fcn_cell_layout::fcn_cell_layout(fcn_dimension_xyz&& lengths, fcn_clocking_scheme&& clocking,
-                                 fcn::technology tech, const std::string& name) noexcept
+                                 fcn::technology tech, const std::string& name, const bool sparse) noexcept
         :
         fcn_layout(std::move(lengths), std::move(clocking)),
         technology{tech},
+        sparse{sparse},
         name{name}
 {}
 
 fcn_cell_layout::fcn_cell_layout(fcn_dimension_xy&& lengths, fcn_clocking_scheme&& clocking,
-                                 fcn::technology tech, const std::string& name) noexcept
+                                 fcn::technology tech, const std::string& name, const bool sparse) noexcept
         :
         fcn_layout(std::move(lengths), std::move(clocking)),
         technology{tech},
+        sparse{sparse},
         name{name}
 {}
 
@@ -31,30 +35,41 @@ fcn_cell_layout::fcn_cell_layout(fcn_gate_library_ptr&& lib)
         technology{library->get_technology()},
         name{library->get_layout()->get_name()}
 {
+    // a byte per cell outweighs hashing the few assigned cells of a tile only if less than every 16th tile is occupied
+    const auto fgl = library->get_layout();
+    sparse = (fgl->gate_count() + fgl->wire_count()) * 16ul < fgl->x() * fgl->y() * fgl->z();
+
+    // all dimensions are known in advance such that the planes can be allocated at once
+    if (!sparse)
+    {
+        store_x = x();
+        store_y = y();
+        store_z = z();
+        cell_store.assign(store_x * store_y * store_z, 0u);
+    }
+
     if (!clocking.regular)
         map_irregular_clocking();
 
     map_layout();
 }
 
-void fcn_cell_layout::assign_cell_type(const cell& c, const fcn::cell_type t) noexcept
+void fcn_cell_layout::assign_cell_type(const cell& c, const fcn::cell_type t)
 {
-    if (t == fcn::EMPTY_CELL)
-        type_map.erase(c);
-    else
-        type_map[c] = t;
+    const auto d = get_cell_data(c);
+    const auto i = type_index(t);
+
+    if ((d >> TYPE_SHIFT) == 0u && i != 0u)
+        ++assigned_cell_count;
+    else if ((d >> TYPE_SHIFT) != 0u && i == 0u)
+        --assigned_cell_count;
+
+    set_cell_data(c, static_cast<cell_data>(i << TYPE_SHIFT | (d & MODE_MASK)));
 }
 
 fcn::cell_type fcn_cell_layout::get_cell_type(const cell& c) const noexcept
 {
-    try
-    {
-        return type_map.at(c);
-    }
-    catch (const std::out_of_range&)
-    {
-        return fcn::EMPTY_CELL;
-    }
+    return cell_types[get_cell_data(c) >> TYPE_SHIFT];
 }
 
 bool fcn_cell_layout::is_free_cell(const cell& c) const noexcept
@@ -64,22 +79,12 @@ bool fcn_cell_layout::is_free_cell(const cell& c) const noexcept
 
 void fcn_cell_layout::assign_cell_mode(const cell& c, const fcn::cell_mode m) noexcept
 {
-    if (m == fcn::cell_mode::NORMAL)
-        mode_map.erase(c);
-    else
-        mode_map[c] = m;
+    set_cell_data(c, static_cast<cell_data>((get_cell_data(c) & ~MODE_MASK) | static_cast<cell_data>(m)));
 }
 
 fcn::cell_mode fcn_cell_layout::get_cell_mode(const cell& c) const noexcept
 {
-    try
-    {
-        return mode_map.at(c);
-    }
-    catch (const std::out_of_range&)
-    {
-        return fcn::cell_mode::NORMAL;
-    }
+    return static_cast<fcn::cell_mode>(get_cell_data(c) & MODE_MASK);
 }
 
 void fcn_cell_layout::assign_cell_name(const cell& c, const std::string& n) noexcept
@@ -92,14 +97,10 @@ void fcn_cell_layout::assign_cell_name(const cell& c, const std::string& n) noex
 
 std::string fcn_cell_layout::get_cell_name(const cell& c) const noexcept
 {
-    try
-    {
-        return name_map.at(c);
-    }
-    catch (const std::out_of_range&)
-    {
-        return "";
-    }
+    if (auto it = name_map.find(c); it != name_map.cend())
+        return it->second;
+
+    return "";
 }
 
 
@@ -110,7 +111,7 @@ void fcn_cell_layout::print_cell(const cell& c, std::ostream& os) const noexcept
 
 std::size_t fcn_cell_layout::cell_count() const noexcept
 {
-    return type_map.size();
+    return assigned_cell_count;
 }
 
 std::optional<fcn_clock::zone> fcn_cell_layout::cell_clocking(const cell& c) const noexcept
@@ -122,14 +123,10 @@ std::optional<fcn_clock::zone> fcn_cell_layout::cell_clocking(const cell& c) con
     }
     else  // irregular clocking accesses clocking map
     {
-        try
-        {
-            return c_map.at(get_ground(c));
-        }
-        catch (const std::out_of_range&)
-        {
-            return std::nullopt;
-        }
+        if (auto it = c_map.find(get_ground(c)); it != c_map.cend())
+            return it->second;
+
+        return std::nullopt;
     }
 }
 
@@ -225,6 +222,78 @@ void fcn_cell_layout::write_layout(std::ostream& os, bool io_color) const noexce
                   << INP_COLOR << "I" << COLOR_RESET << ", " << OUT_COLOR << "O" << COLOR_RESET << std::endl;
 }
 
+fcn_cell_layout::cell_data fcn_cell_layout::get_cell_data(const cell& c) const noexcept
+{
+    if (sparse)
+    {
+        if (auto it = sparse_cells.find(c); it != sparse_cells.cend())
+            return it->second;
+
+        return 0u;
+    }
+
+    if (c[X] >= store_x || c[Y] >= store_y || c[Z] >= store_z)
+        return 0u;
+
+    return cell_store[(c[Z] * store_y + c[Y]) * store_x + c[X]];
+}
+
+void fcn_cell_layout::set_cell_data(const cell& c, const cell_data d) noexcept
+{
+    if (sparse)
+    {
+        if (d == 0u)
+            sparse_cells.erase(c);
+        else
+            sparse_cells[c] = d;
+
+        return;
+    }
+
+    if (c[X] >= store_x || c[Y] >= store_y || c[Z] >= store_z)
+    {
+        // cells without storage already hold the default data
+        if (d == 0u)
+            return;
+
+        // grow geometrically in each dimension that is too small to amortize re-allocations
+        auto grow = [](const std::size_t _old, const std::size_t _req)
+        {
+            return _req < _old ? _old : std::max(_req + 1, _old + _old / 2);
+        };
+
+        const auto new_x = grow(store_x, c[X]), new_y = grow(store_y, c[Y]), new_z = grow(store_z, c[Z]);
+
+        std::vector<cell_data> grown_store(new_x * new_y * new_z, 0u);
+        for (std::size_t z = 0ul; z < store_z; ++z)
+        {
+            for (std::size_t y = 0ul; y < store_y; ++y)
+                std::copy_n(cell_store.cbegin() + static_cast<std::ptrdiff_t>((z * store_y + y) * store_x), store_x,
+                            grown_store.begin() + static_cast<std::ptrdiff_t>((z * new_y + y) * new_x));
+        }
+
+        cell_store = std::move(grown_store);
+        store_x = new_x;
+        store_y = new_y;
+        store_z = new_z;
+    }
+
+    cell_store[(c[Z] * store_y + c[Y]) * store_x + c[X]] = d;
+}
+
+fcn_cell_layout::cell_data fcn_cell_layout::type_index(const fcn::cell_type t)
+{
+    if (auto it = std::find(cell_types.cbegin(), cell_types.cend(), t); it != cell_types.cend())
+        return static_cast<cell_data>(std::distance(cell_types.cbegin(), it));
+
+    // further types would overflow into the mode bits
+    if (cell_types.size() == MAX_CELL_TYPES)
+        throw std::invalid_argument("Too many distinct cell types in layout.");
+
+    cell_types.push_back(t);
+    return static_cast<cell_data>(cell_types.size() - 1ul);
+}
+
 void fcn_cell_layout::map_irregular_clocking()
 {
     auto layout = library->get_layout();
@@ -55,9 +55,11 @@ public:
      * @param clocking Clocking scheme defining possible data flow.
      * @param tech Technology which should be used for this layout.
      * @param name Layout's name.
+     * @param sparse Flag to indicate that cell data should be stored sparsely, i.e. proportional to the number of
+     * assigned cells instead of to the extents spanned by them. Recommended for huge layouts with few assigned cells.
      */
     fcn_cell_layout(fcn_dimension_xyz&& lengths, fcn_clocking_scheme&& clocking,
-                    fcn::technology tech, const std::string& name) noexcept;
+                    fcn::technology tech, const std::string& name, const bool sparse = false) noexcept;
     /**
      * Standard constructor. Creates an FCN cell layout by the means of an array determining its size
      * as well as a clocking scheme defining its data flow possibilities.
@@ -68,12 +70,15 @@ public:
      * @param clocking Clocking scheme defining possible data flow.
      * @param tech Technology which should be used for this layout.
      * @param Layout's name.
+     * @param sparse Flag to indicate that cell data should be stored sparsely, i.e. proportional to the number of
+     * assigned cells instead of to the extents spanned by them. Recommended for huge layouts with few assigned cells.
      */
     fcn_cell_layout(fcn_dimension_xy&& lengths, fcn_clocking_scheme&& clocking,
-                    fcn::technology tech, const std::string& name) noexcept;
+                    fcn::technology tech, const std::string& name, const bool sparse = false) noexcept;
     /**
      * Standard constructor. Creates an FCN cell layout from a gate library that is associated with a fcn_gate_layout.
-     * All tiles from the stored gate layout will be mapped to cells using the library.
+     * All tiles from the stored gate layout will be mapped to cells using the library. Cell data is stored sparsely
+     * iff only a small fraction of the gate layout's tiles is occupied.
      *
      * @param lib FCN gate library to use for mapping operations.
      */
@@ -123,12 +128,13 @@ public:
         return random_face(std::forward<ARGS>(args)...);
     }
     /**
-     * Assigns a cell c with type t to the layout.
+     * Assigns a cell c with type t to the layout. Throws an std::invalid_argument exception if t would be the 65th
+     * distinct cell type in the layout, which cannot be represented (see cell_data).
      *
      * @param c Location of newly to insert cell type.
      * @param t Type of new cell.
      */
-    void assign_cell_type(const cell& c, const fcn::cell_type t) noexcept;
+    void assign_cell_type(const cell& c, const fcn::cell_type t);
     /**
      * Returns the type of cell c. If no cell type was stored before, fcn::EMPTY_CELL is returned.
      *
@@ -181,7 +187,7 @@ public:
     /**
      * Returns the number of assigned cells in the layout. Cell types do not matter.
      *
-     * @return Size of cell_map.
+     * @return Number of cells with a type other than fcn::EMPTY_CELL.
      */
     std::size_t cell_count() const noexcept;
     /**
@@ -242,25 +248,56 @@ private:
      * Technology which is used for the cells in this layout.
      */
     fcn::technology technology;
-    /*
-     * Alias for a hash map that assigns cell types to cells.
+    /**
+     * Type and mode of a cell are packed into a single byte. The lower bits hold the fcn::cell_mode while the upper
+     * ones hold the index of the fcn::cell_type in cell_types. Thereby, up to MAX_CELL_TYPES different cell types can
+     * be used in a layout, which exceeds all types defined in fcn_cell_types.h. Empty cells in normal mode are
+     * represented by 0.
+     */
+    using cell_data = unsigned char;
+    /**
+     * Mask of the mode bits in cell_data.
+     */
+    static constexpr const cell_data MODE_MASK = 0x03u;
+    /**
+     * Offset of the type bits in cell_data.
+     */
+    static constexpr const unsigned TYPE_SHIFT = 2u;
+    /**
+     * Number of distinct cell types that fit into the type bits of cell_data.
+     */
+    static constexpr const std::size_t MAX_CELL_TYPES = 1ul << (8u - TYPE_SHIFT);
+    /**
+     * Flat storage of cell_data, i.e. one dense plane per layer, each of which is addressed in x-major order. Like the
+     * tile storage of fcn_gate_layout, its extents only grow to cover cells that assignments have been made to.
+     * Helper functions for access save memory.
+     */
+    std::vector<cell_data> cell_store{};
+    /**
+     * Flag to indicate that cell data is stored in sparse_cells instead of in cell_store.
      */
-    using cell_type_map = std::unordered_map<cell, fcn::cell_type, boost::hash<cell>>;
+    bool sparse = false;
     /**
-     * Stores mapping cell -> cell_type. Helper functions for access save memory.
+     * Extents of cell_store in each dimension in dense mode.
      */
-    cell_type_map type_map{};
+    std::size_t store_x = 0ul, store_y = 0ul, store_z = 0ul;
     /**
-     * Alias for a hash map that assigns cell modes to cells.
+     * Stores mapping cell -> cell_data for all cells with non-zero data in sparse mode.
      */
-    using cell_mode_map = std::unordered_map<cell, fcn::cell_mode, boost::hash<cell>>;
+    std::unordered_map<cell, cell_data, boost::hash<cell>> sparse_cells{};
     /**
-     * Stores a mapping cell -> cell_mode. Helper functions for access save memory. Crossover mode does not need to be
-     * saved because it is inherently given by the X-coordinate.
+     * All cell types that have been assigned so far. fcn::EMPTY_CELL is located at index 0. All types defined in
+     * fcn_cell_types.h are present from the start such that they can always be represented.
      */
-    cell_mode_map mode_map{};
+    std::vector<fcn::cell_type> cell_types{fcn::EMPTY_CELL, fcn::NORMAL_CELL, fcn::CONST_0_CELL, fcn::CONST_1_CELL,
+                                           fcn::INPUT_CELL, fcn::OUTPUT_CELL};
     /**
-     * Alias for a hash map that assigns names to cells.
+     * Number of cells with a type other than fcn::EMPTY_CELL.
+     */
+    std::size_t assigned_cell_count = 0ul;
+    /**
+     * Alias for a hash map that assigns names to cells. Only I/O cells are named, which is why names are stored
+     * sparsely in any case.
      */
     using cell_name_map = std::unordered_map<cell, std::string, boost::hash<cell>>;
     /**
@@ -271,6 +308,28 @@ private:
      * Layout name.
      */
     std::string name;
+    /**
+     * Returns the packed data of cell c without allocating storage.
+     *
+     * @param c Cell whose data is desired.
+     * @return Data of c or 0 if nothing was ever assigned to c.
+     */
+    cell_data get_cell_data(const cell& c) const noexcept;
+    /**
+     * Stores the packed data d for cell c. Grows cell_store in dense mode if no storage was allocated for c yet.
+     *
+     * @param c Cell whose data is to be stored.
+     * @param d Data to store.
+     */
+    void set_cell_data(const cell& c, const cell_data d) noexcept;
+    /**
+     * Returns the index of cell type t in cell_types and appends t if it has not been assigned before. Throws an
+     * std::invalid_argument exception if cell_types is full already.
+     *
+     * @param t Cell type whose index is desired.
+     * @return Index of t in cell_types.
+     */
+    cell_data type_index(const fcn::cell_type t);
     /**
      * Maps a non-regular clocking taken from a fcn_gate_layout to the cell-level. Therefore, the library's tile size
      * has to be taken into account.
@@ -3,18 +3,23 @@
 //
 
 #include "fcn_gate_layout.h"
+#include "fcn_timing_view.h"
 
 
-fcn_gate_layout::fcn_gate_layout(fcn_dimension_xyz&& lengths, fcn_clocking_scheme&& clocking, logic_network_ptr ln) noexcept
+fcn_gate_layout::fcn_gate_layout(fcn_dimension_xyz&& lengths, fcn_clocking_scheme&& clocking, logic_network_ptr ln,
+                                 const bool sparse) noexcept
         :
         fcn_layout(std::move(lengths), std::move(clocking)),
-        network(std::move(ln))
+        network(std::move(ln)),
+        sparse(sparse)
 {}
 
-fcn_gate_layout::fcn_gate_layout(fcn_dimension_xy&& lengths, fcn_clocking_scheme&& clocking, logic_network_ptr ln) noexcept
+fcn_gate_layout::fcn_gate_layout(fcn_dimension_xy&& lengths, fcn_clocking_scheme&& clocking, logic_network_ptr ln,
+                                 const bool sparse) noexcept
         :
         fcn_layout(fcn_dimension_xyz{lengths[X], lengths[Y], 2}, std::move(clocking)),
-        network(std::move(ln))
+        network(std::move(ln)),
+        sparse(sparse)
 {}
 
 fcn_gate_layout::fcn_gate_layout(fcn_dimension_xy&& lengths, logic_network_ptr ln) noexcept
@@ -87,14 +92,10 @@ std::optional<fcn_clock::zone> fcn_gate_layout::tile_clocking(const tile& t) con
     }
     else  // irregular clocking accesses clocking map
     {
-        try
-        {
-            return c_map.at(get_ground(t));
-        }
-        catch (const std::out_of_range&)
-        {
-            return std::nullopt;
-        }
+        if (auto it = c_map.find(get_ground(t)); it != c_map.cend())
+            return it->second;
+
+        return std::nullopt;
     }
 }
 
@@ -107,174 +108,313 @@ void fcn_gate_layout::assign_logic_vertex(const tile& t, const logic_network::ve
 {
     dissociate_logic_edges(t);
     dissociate_logic_vertex(t);
-    v_map.insert(vertex_map::value_type(t, v));
+
+    // a vertex can only be assigned to one tile at a time
+    if (vertex_tiles.emplace(v, t).second)
+    {
+        access_tile_data(t).vertex = v;
+        ++gate_tile_count;
+    }
 
     // keep track of I/O sets
     if (pi)
         pi_set.emplace(t);
     if (po)
         po_set.emplace(t);
+
+    notify_tile_observers(t);
 }
 
 void fcn_gate_layout::dissociate_logic_vertex(const tile& t) noexcept
 {
-    v_map.left.erase(t);
-
     // keep track of I/O sets
     pi_set.erase(t);
     po_set.erase(t);
 
+    if (!find_tile_data(t))
+        return;
+
+    auto& td = access_tile_data(t);
+    if (td.vertex)
+    {
+        vertex_tiles.erase(*td.vertex);
+        td.vertex = std::nullopt;
+        --gate_tile_count;
+    }
+
     // remove directions associated with t
-    inp_dir_map.erase(t);
-    out_dir_map.erase(t);
+    td.inp_dirs = 0u;
+    td.out_dirs = 0u;
+
+    notify_tile_observers(t);
 }
 
 std::optional<logic_network::vertex> fcn_gate_layout::get_logic_vertex(const tile& t) const noexcept
 {
-    try
-    {
-        return v_map.left.at(t);
-    }
-    catch (const std::out_of_range&)
-    {
-        return std::nullopt;
-    }
+    if (auto td = find_tile_data(t))
+        return td->vertex;
+
+    return std::nullopt;
 }
 
 bool fcn_gate_layout::is_gate_tile(const tile& t) const noexcept
 {
-    try
-    {
-        v_map.left.at(t);
-        return true;
-    }
-    catch (const std::out_of_range&)
-    {
-        return false;
-    }
+    auto td = find_tile_data(t);
+    return td && td->vertex;
 }
 
 bool fcn_gate_layout::has_logic_vertex(const tile& t, const logic_network::vertex v) const noexcept
 {
-    try
-    {
-        return v_map.left.at(t) == v;
-    }
-    catch (const std::out_of_range&)
-    {
-        return false;
-    }
+    auto td = find_tile_data(t);
+    return td && td->vertex && *td->vertex == v;
 }
 
 std::optional<fcn_gate_layout::tile> fcn_gate_layout::get_logic_tile(const logic_network::vertex v) const noexcept
 {
-    try
-    {
-        return v_map.right.at(v);
-    }
-    catch (const std::out_of_range&)
-    {
-        return std::nullopt;
-    }
+    if (auto it = vertex_tiles.find(v); it != vertex_tiles.cend())
+        return it->second;
+
+    return std::nullopt;
 }
 
 void fcn_gate_layout::assign_logic_edge(const tile& t, const logic_network::edge& e) noexcept
 {
     dissociate_logic_vertex(t);
-    e_map[t].emplace(e);
+
+    auto& td = access_tile_data(t);
+    if (std::none_of(td.wires.cbegin(), td.wires.cend(), [&e](const wire_data& _w){return _w.e == e;}))
+    {
+        if (td.wires.empty())
+        {
+            ++wire_tile_count;
+            if (t[Z] != GROUND)
+                ++crossing_tile_count;
+        }
+
+        td.wires.push_back(wire_data{e});
+    }
+
+    notify_tile_observers(t);
 }
 
 void fcn_gate_layout::dissociate_logic_edge(const tile& t, const logic_network::edge& e) noexcept
 {
-    try
-    {
-        e_map.at(t).erase(e);
-        // if this was the last edge assigned, save memory
-        if (e_map.at(t).empty())
-            e_map.erase(t);
+    // if tile t does not have any edges assigned, do nothing
+    if (!is_wire_tile(t))
+        return;
+
+    auto& td = access_tile_data(t);
+    auto it = std::find_if(td.wires.begin(), td.wires.end(), [&e](const wire_data& _w){return _w.e == e;});
+    if (it == td.wires.end())
+        return;
 
-        // remove directions
-        inp_dir_map.at(t) &= ~get_wire_inp_dirs(t, e);
-        out_dir_map.at(t) &= ~get_wire_out_dirs(t, e);
+    // remove directions
+    td.inp_dirs &= static_cast<unsigned char>(~it->inp_dirs);
+    td.out_dirs &= static_cast<unsigned char>(~it->out_dirs);
 
-        edge_inp_dir_map.erase(std::make_pair(t, e));
-        edge_out_dir_map.erase(std::make_pair(t, e));
-    }
-    catch (const std::out_of_range&)
+    td.wires.erase(it);
+    if (td.wires.empty())
     {
-        // if tile t does not have any edges assigned, do nothing
+        --wire_tile_count;
+        if (t[Z] != GROUND)
+            --crossing_tile_count;
     }
+
+    notify_tile_observers(t);
 }
 
 void fcn_gate_layout::dissociate_logic_edges(const tile& t) noexcept
 {
-    inp_dir_map.erase(t);
-    out_dir_map.erase(t);
+    if (!find_tile_data(t))
+        return;
 
-    for (auto& e : get_logic_edges(t))
-    {
-        edge_inp_dir_map.erase(std::make_pair(t, e));
-        edge_out_dir_map.erase(std::make_pair(t, e));
-    }
+    auto& td = access_tile_data(t);
+    td.inp_dirs = 0u;
+    td.out_dirs = 0u;
 
-    e_map.erase(t);
+    clear_wires(t, td);
+
+    notify_tile_observers(t);
 }
 
 fcn_gate_layout::edge_set fcn_gate_layout::get_logic_edges(const tile& t) const noexcept
 {
-    try
+    edge_set edges{};
+    if (auto td = find_tile_data(t))
     {
-        return e_map.at(t);
-    }
-    catch (const std::out_of_range&)
-    {
-        return edge_set{};
+        for (const auto& w : td->wires)
+            edges.push_back(w.e);
     }
+
+    return edges;
 }
 
 bool fcn_gate_layout::is_wire_tile(const tile& t) const noexcept
 {
-    try
-    {
-        return !e_map.at(t).empty();
-    }
-    catch (const std::out_of_range&)
+    auto td = find_tile_data(t);
+    return td && !td->wires.empty();
+}
+
+bool fcn_gate_layout::has_logic_edge(const tile& t, const logic_network::edge& e) const noexcept
+{
+    auto td = find_tile_data(t);
+    return td && std::any_of(td->wires.cbegin(), td->wires.cend(), [&e](const wire_data& _w){return _w.e == e;});
+}
+
+void fcn_gate_layout::clear_tile(const tile& t) noexcept
+{
+    dissociate_logic_vertex(t);
+    dissociate_logic_edges(t);
+    assign_latch(t, 0);
+}
+
+void fcn_gate_layout::assign_clocking(const tile& t, const fcn_clock::number c) noexcept
+{
+    fcn_layout::assign_clocking(t, c);
+
+    notify_tile_observers(t);
+}
+
+void fcn_gate_layout::assign_clocking(const tile_index t, const fcn_clock::number c) noexcept
+{
+    assign_clocking(get_vertex(t), c);
+}
+
+void fcn_gate_layout::assign_latch(const tile& t, const latch_delay l) noexcept
+{
+    fcn_layout::assign_latch(t, l);
+
+    notify_tile_observers(t);
+}
+
+std::size_t fcn_gate_layout::register_tile_observer(tile_observer&& o) noexcept
+{
+    tile_observers.emplace_back(next_observer_id, std::move(o));
+
+    return next_observer_id++;
+}
+
+void fcn_gate_layout::unregister_tile_observer(const std::size_t id) noexcept
+{
+    tile_observers.erase(std::remove_if(tile_observers.begin(), tile_observers.end(),
+                                        [id](const auto& _o){return _o.first == id;}), tile_observers.end());
+}
+
+bool fcn_gate_layout::is_free_tile(const tile& t) const noexcept
+{
+    auto td = find_tile_data(t);
+    return !td || (!td->vertex && td->wires.empty());
+}
+
+std::optional<std::size_t> fcn_gate_layout::store_position(const tile& t) const noexcept
+{
+    if (sparse)
     {
-        return false;
+        if (auto it = sparse_slots.find(t); it != sparse_slots.cend())
+            return it->second;
+
+        return std::nullopt;
     }
+
+    if (t[X] >= store_x || t[Y] >= store_y || t[Z] >= store_z)
+        return std::nullopt;
+
+    return (t[Z] * store_y + t[Y]) * store_x + t[X];
 }
 
-bool fcn_gate_layout::has_logic_edge(const tile& t, const logic_network::edge& e) const noexcept
+fcn_gate_layout::tile fcn_gate_layout::stored_tile(const std::size_t p) const noexcept
+{
+    if (sparse)
+        return slot_tiles[p];
+
+    return tile{p % store_x, (p / store_x) % store_y, p / (store_x * store_y)};
+}
+
+const fcn_gate_layout::tile_data* fcn_gate_layout::find_tile_data(const tile& t) const noexcept
+{
+    if (auto p = store_position(t))
+        return &tile_store[*p];
+
+    return nullptr;
+}
+
+fcn_gate_layout::tile_data& fcn_gate_layout::access_tile_data(const tile& t) noexcept
 {
-    try
+    if (sparse)
     {
-        return e_map.at(t).count(e) > 0u;
+        // storage is proportional to the number of tiles that have ever been assigned
+        if (auto [it, inserted] = sparse_slots.emplace(t, tile_store.size()); !inserted)
+            return tile_store[it->second];
+
+        slot_tiles.push_back(t);
+        return tile_store.emplace_back();
     }
-    catch (const std::out_of_range&)
+
+    if (t[X] >= store_x || t[Y] >= store_y || t[Z] >= store_z)
     {
-        return false;
+        // grow geometrically in each dimension that is too small to amortize re-allocations
+        auto grow = [](const std::size_t _old, const std::size_t _req)
+        {
+            return _req < _old ? _old : std::max(_req + 1, _old + _old / 2);
+        };
+
+        const auto new_x = grow(store_x, t[X]), new_y = grow(store_y, t[Y]), new_z = grow(store_z, t[Z]);
+
+        std::vector<tile_data> grown_store(new_x * new_y * new_z);
+        for (std::size_t z = 0ul; z < store_z; ++z)
+        {
+            for (std::size_t y = 0ul; y < store_y; ++y)
+            {
+                for (std::size_t x = 0ul; x < store_x; ++x)
+                    grown_store[(z * new_y + y) * new_x + x] = std::move(tile_store[(z * store_y + y) * store_x + x]);
+            }
+        }
+
+        tile_store = std::move(grown_store);
+        store_x = new_x;
+        store_y = new_y;
+        store_z = new_z;
     }
+
+    return tile_store[(t[Z] * store_y + t[Y]) * store_x + t[X]];
 }
 
-void fcn_gate_layout::clear_tile(const tile& t) noexcept
+void fcn_gate_layout::clear_wires(const tile& t, tile_data& td) noexcept
 {
-    inp_dir_map.erase(t);
-    out_dir_map.erase(t);
+    if (td.wires.empty())
+        return;
 
-    for (auto& e : get_logic_edges(t))
-    {
-        edge_inp_dir_map.erase(std::make_pair(t, e));
-        edge_out_dir_map.erase(std::make_pair(t, e));
-    }
+    td.wires.clear();
 
-    dissociate_logic_vertex(t);
-    dissociate_logic_edges(t);
-    assign_latch(t, 0);
+    --wire_tile_count;
+    if (t[Z] != GROUND)
+        --crossing_tile_count;
 }
 
-bool fcn_gate_layout::is_free_tile(const tile& t) const noexcept
+void fcn_gate_layout::notify_tile_observers(const tile& t) const noexcept
+{
+    invalidate_metrics();
+
+    for (const auto& [id, o] : tile_observers)
+        o(t);
+}
+
+void fcn_gate_layout::invalidate_metrics() const noexcept
 {
-    return !is_gate_tile(t) && !is_wire_tile(t);
+    metrics.cp_tp.reset();
+    metrics.bb.reset();
+    metrics.energy.reset();
+}
+
+void fcn_gate_layout::validate_metrics() const noexcept
+{
+    if (metrics.x != x() || metrics.y != y() || metrics.z != z())
+    {
+        invalidate_metrics();
+        metrics.x = x();
+        metrics.y = y();
+        metrics.z = z();
+    }
 }
 
 std::optional<fcn_gate_layout::gate_or_wire> fcn_gate_layout::is_data_flow(const gate_or_wire& gw, const tile& at, const bool out) const noexcept
@@ -426,87 +566,27 @@ std::vector<fcn_gate_layout::tile> fcn_gate_layout::incoming_data_flow(const til
 
 operation fcn_gate_layout::get_op(const tile& t) const noexcept
 {
-    try
-    {
-        return network->get_op(v_map.left.at(t));
-    }
-    catch (const std::out_of_range&)
-    {
-        try
-        {
-            return !e_map.at(t).empty() ? operation::W : operation::NONE;
-        }
-        catch (const std::out_of_range&)
-        {
-            return operation::NONE;
-        }
-    }
-}
-
-fcn_gate_layout::path_info fcn_gate_layout::signal_delay(const tile& t, const gate_or_wire& gw, delay_cache& dc) const noexcept
-{
-    if (is_free_tile(t))
-        return {};
-
-    if (auto idf = incoming_data_flow(t, gw); idf.empty())
-        return {1, *tile_clocking(t), 0};
-    else if (dc.count(t))  // cache hit
-        return dc.at(t);
-    else  // cache miss
+    if (auto td = find_tile_data(t))
     {
-        // fetch information about all incoming paths
-        std::vector<path_info> infos{};
-        for (const auto& [_t, _gw] : idf)
-            infos.push_back(signal_delay(_t, _gw, dc));
+        if (td->vertex)
+            return network->get_op(*td->vertex);
 
-        path_info dominant_path{};
-
-        if (is_pi(t))  // primary input in the circuit
-            infos.push_back({1, (*tile_clocking(t) + (num_clocks() - 1)) % num_clocks(), 0});
-
-        if (infos.size() == 1)  // size cannot be 0
-            dominant_path = infos.front();
-        else  // fetch highest delay and difference
-        {
-            // sort by path length
-            std::sort(infos.begin(), infos.end(), [](const auto& i1, const auto& i2) { return i1.length < i2.length; });
-
-            dominant_path.length = infos.back().length;
-            dominant_path.delay = infos.back().delay;
-            dominant_path.diff = infos.back().delay - infos.front().delay;
-        }
-
-        // incorporate self
-        ++dominant_path.length;
-        ++dominant_path.delay;
-
-        // cache value for gates only
-        if (is_gate_tile(t))
-            dc[t] = dominant_path;
-
-        return dominant_path;
+        return !td->wires.empty() ? operation::W : operation::NONE;
     }
+
+    return operation::NONE;
 }
 
 std::pair<std::size_t, std::size_t> fcn_gate_layout::critical_path_length_and_throughput() const noexcept
 {
-    delay_cache dc{};
-    std::size_t critical_path = 0;
-    for (auto&& po : get_pos())
-        critical_path = std::max(signal_delay(po, gate_or_wire{*get_logic_vertex(po)}, dc).length, critical_path);
-
-    std::size_t throughput = 0;
-    if (!dc.empty())
-        throughput = std::max_element(dc.begin(), dc.end(),
-                                      [](const auto& i1, const auto& i2) { return i1.second.diff < i2.second.diff; })->second.diff;
-
-    // give throughput in cycles, not in phases
-    throughput /= num_clocks();
-
-    // convert cycle difference to throughput
-    ++throughput;
+    validate_metrics();
+    if (!metrics.cp_tp)
+    {
+        fcn_timing_view timing{*this};
+        metrics.cp_tp = std::make_pair(timing.critical_path_length(), timing.throughput());
+    }
 
-    return std::make_pair(critical_path, throughput);
+    return *metrics.cp_tp;
 }
 
 void fcn_gate_layout::assign_tile_inp_dir(const tile& t, layout::directions d) noexcept
@@ -515,10 +595,13 @@ void fcn_gate_layout::assign_tile_inp_dir(const tile& t, layout::directions d) n
     if (is_free_tile(t))
         return;
 
+    auto& td = access_tile_data(t);
     if (d == layout::DIR_NONE)
-        inp_dir_map.erase(t);
+        td.inp_dirs = 0u;
     else
-        inp_dir_map[t] |= d;
+        td.inp_dirs |= static_cast<unsigned char>(d.to_ulong());
+
+    notify_tile_observers(t);
 }
 
 void fcn_gate_layout::assign_wire_inp_dir(const tile& t, const logic_network::edge& e, layout::directions d) noexcept
@@ -527,64 +610,55 @@ void fcn_gate_layout::assign_wire_inp_dir(const tile& t, const logic_network::ed
     if (!has_logic_edge(t, e))
         return;
 
+    auto& td = access_tile_data(t);
+    auto& w = *std::find_if(td.wires.begin(), td.wires.end(), [&e](const wire_data& _w){return _w.e == e;});
+
     if (d == layout::DIR_NONE)
     {
-        inp_dir_map.erase(t);
-        edge_inp_dir_map.erase(std::make_pair(t, e));
+        td.inp_dirs = 0u;
+        w.inp_dirs  = 0u;
     }
     else
     {
-        inp_dir_map[t] |= d;
-        edge_inp_dir_map[std::make_pair(t, e)] |= d;
+        td.inp_dirs |= static_cast<unsigned char>(d.to_ulong());
+        w.inp_dirs  |= static_cast<unsigned char>(d.to_ulong());
     }
+
+    notify_tile_observers(t);
 }
 
 bool fcn_gate_layout::is_tile_inp_dir(const tile& t, const layout::directions& d) const noexcept
 {
-    try
-    {
-        return (inp_dir_map.at(t) & d) == d;
-    }
-    catch (const std::out_of_range&)
-    {
-        return d == layout::DIR_NONE;
-    }
+    return (get_tile_inp_dirs(t) & d) == d;
 }
 
 bool fcn_gate_layout::is_wire_inp_dir(const tile& t, const logic_network::edge& e, const layout::directions& d) const noexcept
 {
-    try
-    {
-        return (edge_inp_dir_map.at(std::make_pair(t, e)) & d) == d;
-    }
-    catch (const std::out_of_range&)
-    {
-        return false;
-    }
+    // wires without any input directions do not have any to check for
+    auto dirs = get_wire_inp_dirs(t, e);
+    return dirs.any() && (dirs & d) == d;
 }
 
 layout::directions fcn_gate_layout::get_tile_inp_dirs(const tile& t) const noexcept
 {
-    try
-    {
-        return (inp_dir_map.at(t));
-    }
-    catch (const std::out_of_range&)
-    {
-        return layout::DIR_NONE;
-    }
+    if (auto td = find_tile_data(t))
+        return layout::directions{td->inp_dirs};
+
+    return layout::DIR_NONE;
 }
 
 layout::directions fcn_gate_layout::get_wire_inp_dirs(const tile& t, const logic_network::edge& e) const noexcept
 {
-    try
+    if (auto td = find_tile_data(t))
     {
-        return (edge_inp_dir_map.at(std::make_pair(t, e)));
-    }
-    catch (const std::out_of_range&)
-    {
-        return layout::DIR_NONE;
+        for (const auto& w : td->wires)
+        {
+            if (w.e == e)
+                return layout::directions{w.inp_dirs};
+        }
     }
+
+    return layout::DIR_NONE;
 }
 
 void fcn_gate_layout::assign_tile_out_dir(const tile& t, layout::directions d) noexcept
@@ -593,10 +667,13 @@ void fcn_gate_layout::assign_tile_out_dir(const tile& t, layout::directions d) n
     if (is_free_tile(t))
         return;
 
+    auto& td = access_tile_data(t);
     if (d == layout::DIR_NONE)
-        out_dir_map.erase(t);
+        td.out_dirs = 0u;
     else
-        out_dir_map[t] |= d;
+        td.out_dirs |= static_cast<unsigned char>(d.to_ulong());
+
+    notify_tile_observers(t);
 }
 
 void fcn_gate_layout::assign_wire_out_dir(const tile& t, const logic_network::edge& e, layout::directions d) noexcept
@@ -605,65 +682,55 @@ void fcn_gate_layout::assign_wire_out_dir(const tile& t, const logic_network::ed
     if (!has_logic_edge(t, e))
         return;
 
+    auto& td = access_tile_data(t);
+    auto& w = *std::find_if(td.wires.begin(), td.wires.end(), [&e](const wire_data& _w){return _w.e == e;});
+
     if (d == layout::DIR_NONE)
     {
-        out_dir_map.erase(t);
-        edge_out_dir_map.erase(std::make_pair(t, e));
+        td.out_dirs = 0u;
+        w.out_dirs  = 0u;
     }
     else
     {
-        out_dir_map[t] |= d;
-        edge_out_dir_map[std::make_pair(t, e)] |= d;
+        td.out_dirs |= static_cast<unsigned char>(d.to_ulong());
+        w.out_dirs  |= static_cast<unsigned char>(d.to_ulong());
     }
+
+    notify_tile_observers(t);
 }
 
 bool fcn_gate_layout::is_tile_out_dir(const tile& t, const layout::directions& d) const noexcept
 {
-    try
-    {
-        return (out_dir_map.at(t) & d) == d;
-    }
-    catch (const std::out_of_range&)
-    {
-        return d == layout::DIR_NONE;
-    }
+    return (get_tile_out_dirs(t) & d) == d;
 }
 
 bool fcn_gate_layout::is_wire_out_dir(const tile& t, const logic_network::edge& e, const layout::directions& d) const noexcept
 {
-    try
-    {
-        return (edge_out_dir_map.at(std::make_pair(t, e)) & d) == d;
-    }
-    catch (const std::out_of_range&)
-    {
-        return false;
-    }
-
+    // wires without any output directions do not have any to check for
+    auto dirs = get_wire_out_dirs(t, e);
+    return dirs.any() && (dirs & d) == d;
 }
 
 layout::directions fcn_gate_layout::get_tile_out_dirs(const tile& t) const noexcept
 {
-    try
-    {
-        return (out_dir_map.at(t));
-    }
-    catch (const std::out_of_range&)
-    {
-        return layout::DIR_NONE;
-    }
+    if (auto td = find_tile_data(t))
+        return layout::directions{td->out_dirs};
+
+    return layout::DIR_NONE;
 }
 
 layout::directions fcn_gate_layout::get_wire_out_dirs(const tile& t, const logic_network::edge& e) const noexcept
 {
-    try
+    if (auto td = find_tile_data(t))
     {
-        return (edge_out_dir_map.at(std::make_pair(t, e)));
-    }
-    catch (const std::out_of_range&)
-    {
-        return layout::DIR_NONE;
+        for (const auto& w : td->wires)
+        {
+            if (w.e == e)
+                return layout::directions{w.out_dirs};
+        }
     }
+
+    return layout::DIR_NONE;
 }
 
 layout::directions fcn_gate_layout::get_unused_tile_dirs(const tile& t) const noexcept
@@ -773,85 +840,32 @@ logic_network_ptr fcn_gate_layout::get_network() const noexcept
 
 fcn_gate_layout::bounding_box fcn_gate_layout::determine_bounding_box() const noexcept
 {
-    // calculate min_x
-    std::size_t min_x = 0u;
-    for (std::size_t x = 0u; x < this->x(); ++x)
-    {
-        bool elem_found = false;
-        for (std::size_t y = 0u; y < this->y(); ++y)
-        {
-            if (!this->is_free_tile(tile{x, y, GROUND}) || !this->is_free_tile(tile{x, y, 1}))
-            {
-                elem_found = true;
-                break;
-            }
-        }
-
-        min_x = x;
-        if (elem_found)
-            break;
-    }
+    validate_metrics();
+    if (metrics.bb)
+        return *metrics.bb;
 
-    // calculate min_y
-    std::size_t min_y = 0u;
-    for (std::size_t y = 0u; y < this->y(); ++y)
+    // only stored tiles can be occupied; hence, the layout's area does not need to be scanned
+    std::optional<std::size_t> min_x{}, min_y{}, max_x{}, max_y{};
+    for (std::size_t p = 0ul; p < tile_store.size(); ++p)
     {
-        bool elem_found = false;
-        for (std::size_t x = 0u; x < this->x(); ++x)
-        {
-            if (!this->is_free_tile(tile{x, y, GROUND}) || !this->is_free_tile(tile{x, y, 1}))
-            {
-                elem_found = true;
-                break;
-            }
-        }
+        if (!tile_store[p].vertex && tile_store[p].wires.empty())
+            continue;
 
-        min_y = y;
-        if (elem_found)
-            break;
-    }
-
-    // calculate max_x
-    std::size_t max_x = this->x() - 1;
-    for (long x = this->x() - 1; x >= 0; --x)
-    {
-        bool elem_found = false;
-        for (std::size_t y = 0u; y < this->y(); ++y)
-        {
-            if (!this->is_free_tile(tile{static_cast<std::size_t>(x), y, GROUND}) ||
-                    !this->is_free_tile(tile{static_cast<std::size_t>(x), y, 1}))
-            {
-                elem_found = true;
-                break;
-            }
-        }
+        const auto t = stored_tile(p);
+        if (t[X] >= this->x() || t[Y] >= this->y() || t[Z] > 1)
+            continue;
 
-        max_x = static_cast<std::size_t>(x);
-        if (elem_found)
-            break;
+        min_x = std::min(min_x.value_or(t[X]), t[X]);
+        min_y = std::min(min_y.value_or(t[Y]), t[Y]);
+        max_x = std::max(max_x.value_or(t[X]), t[X]);
+        max_y = std::max(max_y.value_or(t[Y]), t[Y]);
     }
 
-    // calculate max_y
-    std::size_t max_y = this->y() - 1;
-    for (long y = this->y() - 1; y >= 0; --y)
-    {
-        bool elem_found = false;
-        for (std::size_t x = 0u; x < this->x(); ++x)
-        {
-            if (!this->is_free_tile(tile{x, static_cast<std::size_t>(y), GROUND}) ||
-                    !this->is_free_tile(tile{x, static_cast<std::size_t>(y), 1}))
-            {
-                elem_found = true;
-                break;
-            }
-        }
+    // an empty layout yields the bounding box of a grid scan that did not find any element
+    metrics.bb.emplace(min_x.value_or(this->x() - 1), min_y.value_or(this->y() - 1),
+                       max_x.value_or(0ul), max_y.value_or(0ul));
 
-        max_y = static_cast<std::size_t>(y);
-        if (elem_found)
-            break;
-    }
-
-    return bounding_box{min_x, min_y, max_x, max_y};
+    return *metrics.bb;
 }
 
 void fcn_gate_layout::shrink_to_fit() noexcept
@@ -862,6 +876,10 @@ void fcn_gate_layout::shrink_to_fit() noexcept
 
 fcn_gate_layout::energy_info fcn_gate_layout::calculate_energy() const noexcept
 {
+    validate_metrics();
+    if (metrics.energy)
+        return *metrics.energy;
+
     float slow_energy = 0.0f, fast_energy = 0.0f;
 
     auto num_wires = wire_count();
@@ -878,7 +896,7 @@ fcn_gate_layout::energy_info fcn_gate_layout::calculate_energy() const noexcept
     // counting gates
     auto num_inv_s = 0u, num_inv_b = 0u, num_and = 0u, num_or = 0u, num_maj = 0u, num_fan_out = 0u;
 
-    for (auto&& [t, v] : v_map.left)
+    for (auto&& [v, t] : vertex_tiles)
     {
         (void)v;  // fix compiler warning
         switch (get_op(t))
@@ -930,7 +948,9 @@ fcn_gate_layout::energy_info fcn_gate_layout::calculate_energy() const noexcept
     slow_energy += num_fan_out * energy::FANOUT_SLOW;
     fast_energy += num_fan_out * energy::FANOUT_FAST;
 
-    return std::make_pair(slow_energy, fast_energy);
+    metrics.energy = std::make_pair(slow_energy, fast_energy);
+
+    return *metrics.energy;
 }
 
 void fcn_gate_layout::write_layout(std::ostream& os, bool io_color, bool clk_color) const noexcept
@@ -11,8 +11,10 @@
 #include "energy_model.h"
 #include <optional>
 #include <variant>
-#include <boost/bimap.hpp>
-#include <boost/bimap/unordered_set_of.hpp>
+#include <functional>
+#include <vector>
+#include <unordered_set>
+#include <boost/container/small_vector.hpp>
 
 /**
  * Represents layouts of field-coupled nanocomputing (FCN) devices on a gate level abstraction. Inherits from fcn_layout
@@ -66,6 +68,10 @@ public:
      * Granting access to private data members for design_checker.
      */
     friend class design_checker;
+    /**
+     * Granting access to private data members for fcn_timing_view.
+     */
+    friend class fcn_timing_view;
     /**
      * Standard constructor. Creates an FCN gate layout by the means of an array determining its size
      * as well as a clocking scheme defining its data flow possibilities.
@@ -76,8 +82,11 @@ public:
      * See https://svn.boost.org/trac10/ticket/11735 for details.
      * @param clocking Clocking scheme defining possible data flow.
      * @param ln Pointer to a logic network whose elements should be assigned to this layout.
+     * @param sparse Flag to indicate that tile data should be stored sparsely, i.e. proportional to the number of
+     * occupied tiles instead of to the extents spanned by them. Recommended for huge layouts with few occupied tiles.
      */
-    fcn_gate_layout(fcn_dimension_xyz&& lengths, fcn_clocking_scheme&& clocking, logic_network_ptr ln) noexcept;
+    fcn_gate_layout(fcn_dimension_xyz&& lengths, fcn_clocking_scheme&& clocking, logic_network_ptr ln,
+                    const bool sparse = false) noexcept;
     /**
      * Standard constructor. Creates an FCN gate layout by the means of an array determining its size
      * as well as a clocking scheme defining its data flow possibilities.
@@ -87,8 +96,11 @@ public:
      * See https://svn.boost.org/trac10/ticket/11735 for details.
      * @param clocking Clocking scheme defining possible data flow.
      * @param ln Pointer to a logic network whose elements should be assigned to this layout.
+     * @param sparse Flag to indicate that tile data should be stored sparsely, i.e. proportional to the number of
+     * occupied tiles instead of to the extents spanned by them. Recommended for huge layouts with few occupied tiles.
      */
-    fcn_gate_layout(fcn_dimension_xy&& lengths, fcn_clocking_scheme&& clocking, logic_network_ptr ln) noexcept;
+    fcn_gate_layout(fcn_dimension_xy&& lengths, fcn_clocking_scheme&& clocking, logic_network_ptr ln,
+                    const bool sparse = false) noexcept;
     /**
      * Standard constructor. Creates an FCN gate layout by the means of an array determining its size
      * as well as a clocking scheme defining its data flow possibilities.
@@ -121,9 +133,9 @@ public:
      */
     fcn_gate_layout(const fcn_gate_layout& fgl) = delete;
     /**
-     * Default move constructor.
+     * Move constructor is not available because registered tile observers refer to the layout they observe.
      */
-    fcn_gate_layout(fcn_gate_layout&& fgl) = default;
+    fcn_gate_layout(fcn_gate_layout&& fgl) = delete;
     /**
      * Default destructor.
      */
@@ -326,9 +338,10 @@ public:
     void dissociate_logic_edges(const tile& t) noexcept;
 private:
     /**
-     * Alias for a hash set of logic edges. (Kind of "forward declaration".)
+     * Alias for a small set of logic edges that is stored inline for the common case of at most two edges per tile.
+     * (Kind of "forward declaration".)
      */
-    using edge_set = std::unordered_set<logic_network::edge, boost::hash<logic_network::edge>>;
+    using edge_set = boost::container::small_vector<logic_network::edge, 2>;
 public:
     /**
      * Returns the logic_network::edges assigned to tile t. Returns an empty set if there are none.
@@ -358,6 +371,47 @@ public:
      * @param t Tile to clear.
      */
     void clear_tile(const tile& t) noexcept;
+    /**
+     * Assigns clock number c to tile t like fcn_layout::assign_clocking does and notifies tile observers. Overrides
+     * the base version so that changes made via an fcn_layout reference are observed as well.
+     *
+     * @param t Tile to which clock number c should be assigned.
+     * @param c Clock number to assign to tile t.
+     */
+    void assign_clocking(const tile& t, const fcn_clock::number c) noexcept override;
+    /**
+     * Assigns clock number c to the tile with index t like fcn_layout::assign_clocking does and notifies tile observers.
+     *
+     * @param t Index of the tile to which clock number c should be assigned.
+     * @param c Clock number to assign to the tile.
+     */
+    void assign_clocking(const tile_index t, const fcn_clock::number c) noexcept;
+    /**
+     * Assigns latch delay l to tile t like fcn_layout::assign_latch does and notifies tile observers. Overrides the
+     * base version so that changes made via an fcn_layout reference are observed as well.
+     *
+     * @param t Tile (stack) to which latch delay l should be assigned.
+     * @param l Latch in clock phases to be assigned to tile (stack) t.
+     */
+    void assign_latch(const tile& t, const latch_delay l) noexcept override;
+    /**
+     * Callback that is invoked with a tile whenever its assigned logic vertex or edges, its directions, its clock
+     * number, or its latch change.
+     */
+    using tile_observer = std::function<void(const tile&)>;
+    /**
+     * Registers an observer that is notified about all subsequent changes of tiles.
+     *
+     * @param o Observer to register.
+     * @return Identifier with which o can be unregistered.
+     */
+    std::size_t register_tile_observer(tile_observer&& o) noexcept;
+    /**
+     * Unregisters a previously registered observer.
+     *
+     * @param id Identifier returned by register_tile_observer.
+     */
+    void unregister_tile_observer(const std::size_t id) noexcept;
     /**
      * Checks for the existence of logic vertices or edges assigned to the given tile.
      *
@@ -464,7 +518,7 @@ public:
      */
     auto gate_count() const noexcept
     {
-        return v_map.size();
+        return gate_tile_count;
     }
     /**
      * Returns the number of tiles that are assigned with logic edges. Note that wire tiles in higher layers are counted
@@ -474,7 +528,7 @@ public:
      */
     auto wire_count() const noexcept
     {
-        return e_map.size();
+        return wire_tile_count;
     }
     /**
      * Returns the number of logic edges assigned to tiles above ground layer.
@@ -483,7 +537,7 @@ public:
      */
     auto crossing_count() const noexcept
     {
-        return std::count_if(e_map.cbegin(), e_map.cend(), [](auto& te){return te.first[Z] != GROUND;});
+        return crossing_tile_count;
     }
     /**
      * Container to store statistical information about paths.
@@ -495,24 +549,6 @@ public:
          */
         std::size_t length = 0, delay = 0, diff = 0;
     };
-    /**
-     * Alias for a cache structure to store delay and throughput values to avoid re-computations.
-     */
-    using delay_cache = std::unordered_map<tile, path_info, boost::hash<tile>>;
-    /**
-     * Returns the number of tiles of the longest path in the layout from a primary input to t. Information is stored in
-     * a wrapper struct that comes with path length in tiles (length), path length in tiles starting with clock zone of
-     * PI (delay), and the delay differences leading to t (diff). If t is an empty tile, all those values are 0.
-     *
-     * A delay cache is used to store partial results. It caches gate values only, because wires are only computed once
-     * anyways. This way, the cache is just a slight memory overhead but significantly reduces runtime.
-     *
-     * @param t Tile whose number of tiles on the longest path from any PI is desired.
-     * @param gw Gate or wire assigned to tile t to trace the signal path.
-     * @param dc A cache structure to avoid re-computations of paths.
-     * @return Number of tiles in the longest path from a PI to t in several configurations.
-     */
-    path_info signal_delay(const tile& t, const gate_or_wire& gw, delay_cache& dc) const noexcept;
     /**
      * Returns the length of the longest path from any PI to any PO, i.e. the highest signal delay in tiles as the first
      * return value.
@@ -520,11 +556,12 @@ public:
      * Returns the lowest signal throughput of all gates as the second one. It is given as 1/x where only x is returned,
      * i.e. a high x means a low throughput. For this sake, throughput for a gate is given as the difference in signal
      * path lengths of all its longest input paths. Throughput of the layout is the largest of those differences. Since
-     * they are multiples of num_clocks() by definition of signal_delay(t, true), the result is divided by num_clocks()
-     * to be left with the reduction in cycles instead of phases.
+     * they are multiples of num_clocks() by definition of path_info::delay, the result is divided by num_clocks() to be
+     * left with the reduction in cycles instead of phases.
      *
      * This function returns both because both can (and should) be computed at once since it uses the same data and is
-     * costly to calculate.
+     * costly to calculate. Both are computed by an fcn_timing_view which should be used directly if path information of
+     * single tiles is needed as well. The result is cached until the next alteration of the layout.
      *
      * @return Pair of length of the critical path and throughput of the layout (1/x where only x is returned).
      */
@@ -774,7 +811,7 @@ public:
     };
     /**
      * Determines the layout's bounding box i.e. the area in which logic elements are placed. Helps to determine the
-     * "real" size of a layout.
+     * "real" size of a layout. The result is cached until the next alteration of the layout.
      *
      * @return Bounding box.
      */
@@ -791,7 +828,8 @@ public:
     using energy_info = std::pair<float, float>;
     /**
      * Calculates energy dissipation of the layout by taking into account the energy model proposed by Frank Sill Torres
-     * et al. in TCAD 2018. Information about slow clocking (25 GHz) and fast clocking (100 GHz) energy is returned.
+     * et al. in TCAD 2018. Information about slow clocking (25 GHz) and fast clocking (100 GHz) energy is returned. The
+     * result is cached until the next alteration of the layout.
      *
      * @return An std::pair containing slow and fast energy dissipation in meV.
      */
@@ -813,46 +851,155 @@ private:
      */
     logic_network_ptr network = nullptr;
     /**
-     * Alias for a hashed bidirectional map that assigns logic vertices to the tiles and vice versa.
+     * A logic edge assigned to a tile together with its input and output directions packed into bytes.
+     */
+    struct wire_data
+    {
+        /**
+         * Assigned logic edge.
+         */
+        logic_network::edge e;
+        /**
+         * Input and output directions of e on the tile.
+         */
+        unsigned char inp_dirs = 0u, out_dirs = 0u;
+    };
+    /**
+     * Everything that can be assigned to a single tile. Since a tile can hold either one vertex or multiple edges,
+     * tile-wide directions are complete for vertices and are the union of all edge directions for wires.
      */
-    using vertex_map = boost::bimap<boost::bimaps::unordered_set_of<tile, boost::hash<tile>>,
-            boost::bimaps::unordered_set_of<logic_network::vertex, boost::hash<logic_network::vertex>>>;
+    struct tile_data
+    {
+        /**
+         * Assigned logic vertex if there is one.
+         */
+        std::optional<logic_network::vertex> vertex{};
+        /**
+         * Assigned logic edges with their respective directions. Stored inline for a single edge.
+         */
+        boost::container::small_vector<wire_data, 1> wires{};
+        /**
+         * Input and output directions of the tile packed into bytes.
+         */
+        unsigned char inp_dirs = 0u, out_dirs = 0u;
+    };
     /**
-     * Stores mapping tile -> logic_network::vertex. Helper functions for access save memory.
+     * Flat storage of tile_data. In dense mode, it is addressed in x-major order and its extents are independent of the
+     * layout's dimensions. They only grow to cover tiles that assignments have been made to. That way, assignments
+     * survive resizing like they did in a hash map and layouts that are created oversized and shrunk to fit afterwards
+     * do not allocate storage for their empty parts. In sparse mode, a slot is appended for each tile on its first
+     * assignment instead and the slots are addressed via sparse_slots. Helper functions for access save memory.
      */
-    vertex_map v_map{};
+    std::vector<tile_data> tile_store{};
     /**
-     * Alias for a hash map that assigns sets of logic edges to the tiles.
+     * Flag to indicate that tile_store is operated in sparse mode.
      */
-    using edge_map = std::unordered_map<tile, edge_set, boost::hash<tile>>;
+    bool sparse = false;
     /**
-     * Stores mapping tile -> set of logic_network::edge. Note that several edges per tile are possible.
-     * Helper functions for access save memory.
+     * Extents of tile_store in each dimension in dense mode.
      */
-    edge_map e_map{};
+    std::size_t store_x = 0ul, store_y = 0ul, store_z = 0ul;
     /**
-     * Alias for a hash map that assigns directions to the tiles.
+     * Maps tiles to their slots in tile_store in sparse mode.
      */
-    using direction_map = std::unordered_map<tile, layout::directions, boost::hash<tile>>;
+    std::unordered_map<tile, std::size_t, boost::hash<tile>> sparse_slots{};
+    /**
+     * Tiles of all slots in tile_store in sparse mode.
+     */
+    std::vector<tile> slot_tiles{};
+    /**
+     * Stores mapping logic_network::vertex -> tile for the reverse lookup of vertex assignments.
+     */
+    std::unordered_map<logic_network::vertex, tile> vertex_tiles{};
+    /**
+     * Number of tiles assigned with a logic vertex, with logic edges, and with logic edges above ground layer.
+     */
+    std::size_t gate_tile_count = 0ul, wire_tile_count = 0ul, crossing_tile_count = 0ul;
+    /**
+     * Returns the position of tile t in tile_store.
+     *
+     * @param t Tile whose position is desired.
+     * @return Position of t's data in tile_store or std::nullopt if no storage was ever allocated for t.
+     */
+    std::optional<std::size_t> store_position(const tile& t) const noexcept;
+    /**
+     * Returns the tile whose data is stored at position p in tile_store.
+     *
+     * @param p Position in tile_store.
+     * @return Tile stored at p.
+     */
+    tile stored_tile(const std::size_t p) const noexcept;
+    /**
+     * Returns the stored data of tile t without allocating storage.
+     *
+     * @param t Tile whose data is desired.
+     * @return Pointer to t's data or nullptr if nothing was ever assigned to t's position.
+     */
+    const tile_data* find_tile_data(const tile& t) const noexcept;
+    /**
+     * Returns the stored data of tile t for modification. Grows tile_store if no storage was allocated for t yet.
+     *
+     * @param t Tile whose data is desired.
+     * @return Reference to t's data.
+     */
+    tile_data& access_tile_data(const tile& t) noexcept;
+    /**
+     * Removes all wires from the given tile data and updates the tile counters accordingly.
+     *
+     * @param t Tile that td belongs to.
+     * @param td Data of tile t.
+     */
+    void clear_wires(const tile& t, tile_data& td) noexcept;
+    /**
+     * Registered tile observers together with their identifiers.
+     */
+    std::vector<std::pair<std::size_t, tile_observer>> tile_observers{};
+    /**
+     * Identifier assigned to the next registered tile observer.
+     */
+    std::size_t next_observer_id = 0ul;
+    /**
+     * Invokes all registered tile observers with tile t.
+     *
+     * @param t Changed tile.
+     */
+    void notify_tile_observers(const tile& t) const noexcept;
+    /**
+     * Lazily computed layout metrics. Each one is computed on its first query and kept until a tile is altered or the
+     * layout is resized so that repeated statistics queries, e.g. by the store, are cheap.
+     */
+    struct metrics_cache
+    {
+        /**
+         * Critical path length and throughput.
+         */
+        std::optional<std::pair<std::size_t, std::size_t>> cp_tp{};
+        /**
+         * Bounding box.
+         */
+        std::optional<bounding_box> bb{};
+        /**
+         * Energy dissipation.
+         */
+        std::optional<energy_info> energy{};
+        /**
+         * Layout dimensions the metrics were computed for.
+         */
+        std::size_t x = 0ul, y = 0ul, z = 0ul;
+    };
     /**
-     * Stores mapping tile -> directions for inputs and outputs respectively.
-     * Helper functions for access save memory.
+     * Cached metrics of this layout.
      */
-    direction_map inp_dir_map{}, out_dir_map{};
+    mutable metrics_cache metrics{};
     /**
-     * Alias for a hash map that assigns directions to pairs of tiles and logic_network::edges to allow for a complete
-     * many-to-many relation.
+     * Discards all cached metrics.
      */
-    using edge_direction_map = std::unordered_map<std::pair<tile, logic_network::edge>, layout::directions,
-            boost::hash<std::pair<tile, logic_network::edge>>>;
+    void invalidate_metrics() const noexcept;
     /**
-     * Stores mapping std::pair<tile, logic_network::edge> to directions for inputs and outputs respectively. Since a
-     * single tile can hold either one vertex or multiple edges, the direction set above is already complete for
-     * vertices but needs extension for edges. inp_dir_map and out_dir_map furthermore hold combinations of all
-     * available directions for the respective tiles.
-     * Helper functions for access save memory.
+     * Discards all cached metrics if the layout has been resized since they were computed. Called by all queries
+     * that make use of the cache since fcn_layout::resize does not notify tile observers.
      */
-    edge_direction_map edge_inp_dir_map{}, edge_out_dir_map{};
+    void validate_metrics() const noexcept;
     /**
      * Alias for a hash set that holds tiles to represent PI/PO ports.
      */
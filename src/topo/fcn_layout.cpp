@@ -156,14 +156,10 @@ void fcn_layout::assign_latch(const face& f, const latch_delay l) noexcept
 
 fcn_layout::latch_delay fcn_layout::get_latch(const face& f) const noexcept
 {
-    try
-    {
-        return l_map.at(get_ground(f));
-    }
-    catch (const std::out_of_range&)
-    {
-        return 0u;
-    }
+    if (auto it = l_map.find(get_ground(f)); it != l_map.cend())
+        return it->second;
+
+    return 0u;
 }
 
 std::vector<std::string> fcn_layout::latch_str_reprs() const noexcept
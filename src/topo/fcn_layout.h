@@ -369,7 +369,7 @@ public:
      * @param f Face to which clock number c should be assigned.
      * @param c Clock number to assign to face f.
      */
-    void assign_clocking(const face& f, const fcn_clock::number c) noexcept;
+    virtual void assign_clocking(const face& f, const fcn_clock::number c) noexcept;
     /**
      * Assigns a clock number c to the given index' face f. The clock number will only be assigned if the stored
      * clocking scheme is irregular and if c <= clocking.num_clocks hold. Otherwise, this function does nothing.
@@ -393,7 +393,7 @@ public:
      * @param f Face (stack) to which an artificial latch delay should be assigned.
      * @param l Latch in clock phases to be assigned to face (stack) f.
      */
-    void assign_latch(const face& f, const latch_delay l) noexcept;
+    virtual void assign_latch(const face& f, const latch_delay l) noexcept;
     /**
      * Returns a previously assigned latch delay of the given face f. If no latch delay was previously assigned, 0 is
      * returned as a default value which corresponds to no artificial delay is assumed.
@@ -0,0 +1,400 @@
+//
+// fcn_timing_view.cpp
+//
+
+#include "fcn_timing_view.h"
+
+
+fcn_timing_view::fcn_timing_view(const fcn_gate_layout& fgl) noexcept
+        :
+        layout{fgl}
+{
+    rehash();
+
+    // create a node for each gate and wire segment on tiles within the layout's bounds
+    for (std::size_t p = 0ul; p < heads.size(); ++p)
+        create_nodes(layout.stored_tile(p));
+
+    // determine incoming data flow of each node exactly once
+    std::vector<std::size_t> all(nodes.size());
+    for (std::size_t n = 0ul; n < nodes.size(); ++n)
+    {
+        link(n);
+        all[n] = n;
+    }
+
+    propagate(all);
+}
+
+fcn_timing_view::fcn_timing_view(fcn_gate_layout& fgl, const bool incremental) noexcept
+        :
+        fcn_timing_view(static_cast<const fcn_gate_layout&>(fgl))
+{
+    if (incremental)
+    {
+        observed = &fgl;
+        observer_id = fgl.register_tile_observer([this](const tile& _t){dirty.push_back(tile{_t[X], _t[Y], GROUND});});
+    }
+}
+
+fcn_timing_view::~fcn_timing_view()
+{
+    if (observed && observer_id)
+        observed->unregister_tile_observer(*observer_id);
+}
+
+fcn_timing_view::path_info fcn_timing_view::signal_delay(const tile& t, const gate_or_wire& gw) noexcept
+{
+    update();
+
+    if (auto n = find_node(t, gw))
+        return nodes[*n].info;
+
+    return {};
+}
+
+fcn_timing_view::path_info fcn_timing_view::signal_delay(const tile& t) noexcept
+{
+    update();
+
+    path_info longest{};
+
+    if (auto p = position(t))
+    {
+        for (auto n = heads[*p]; n; n = nodes[*n].next)
+        {
+            if (nodes[*n].info.length > longest.length)
+                longest = nodes[*n].info;
+        }
+    }
+
+    return longest;
+}
+
+std::size_t fcn_timing_view::critical_path_length() noexcept
+{
+    update();
+
+    return po_lengths.empty() ? 0ul : po_lengths.crbegin()->first;
+}
+
+std::size_t fcn_timing_view::max_delay_difference() noexcept
+{
+    update();
+
+    return diffs.empty() ? 0ul : diffs.crbegin()->first;
+}
+
+std::size_t fcn_timing_view::throughput() noexcept
+{
+    // give throughput in cycles, not in phases and convert cycle difference to throughput
+    return max_delay_difference() / layout.num_clocks() + 1;
+}
+
+void fcn_timing_view::update() noexcept
+{
+    if (dirty.empty())
+        return;
+
+    // tile storage might have grown to hold new assignments
+    if (layout.tile_store.size() != heads.size())
+        rehash();
+
+    std::sort(dirty.begin(), dirty.end());
+    dirty.erase(std::unique(dirty.begin(), dirty.end()), dirty.end());
+
+    // data flow into a tile only depends on the tile itself and its adjacent stacks
+    std::vector<tile> region{};
+    for (const auto& d : dirty)
+    {
+        for (std::size_t z = 0ul; z < layout.z(); ++z)
+        {
+            const tile t{d[X], d[Y], z};
+            remove_nodes(t);
+            create_nodes(t);
+
+            region.push_back(t);
+            if (d[X] > 0ul)
+                region.push_back(tile{d[X] - 1, d[Y], z});
+            if (d[X] + 1 < layout.x())
+                region.push_back(tile{d[X] + 1, d[Y], z});
+            if (d[Y] > 0ul)
+                region.push_back(tile{d[X], d[Y] - 1, z});
+            if (d[Y] + 1 < layout.y())
+                region.push_back(tile{d[X], d[Y] + 1, z});
+        }
+    }
+    dirty.clear();
+
+    std::sort(region.begin(), region.end());
+    region.erase(std::unique(region.begin(), region.end()), region.end());
+
+    std::vector<std::size_t> seeds{};
+    for (const auto& t : region)
+    {
+        if (auto p = position(t))
+        {
+            for (auto n = heads[*p]; n; n = nodes[*n].next)
+            {
+                unlink(*n);
+                link(*n);
+                seeds.push_back(*n);
+            }
+        }
+    }
+
+    propagate(seeds);
+}
+
+std::optional<std::size_t> fcn_timing_view::position(const tile& t) const noexcept
+{
+    if (auto p = layout.store_position(t); p && *p < heads.size())
+        return p;
+
+    return std::nullopt;
+}
+
+std::optional<std::size_t> fcn_timing_view::find_node(const tile& t, const gate_or_wire& gw) const noexcept
+{
+    if (auto p = position(t))
+    {
+        for (auto n = heads[*p]; n; n = nodes[*n].next)
+        {
+            if (nodes[*n].gw == gw)
+                return n;
+        }
+    }
+
+    return std::nullopt;
+}
+
+void fcn_timing_view::rehash() noexcept
+{
+    heads.assign(layout.tile_store.size(), std::nullopt);
+
+    // re-chain nodes in reverse to preserve their order per tile
+    for (std::size_t n = nodes.size(); n-- > 0;)
+    {
+        if (auto& node = nodes[n]; node.alive)
+        {
+            auto p = *position(node.t);
+            node.next = heads[p];
+            heads[p] = n;
+        }
+    }
+}
+
+void fcn_timing_view::create_nodes(const tile& t) noexcept
+{
+    if (t[X] >= layout.x() || t[Y] >= layout.y() || t[Z] >= layout.z())
+        return;
+
+    const auto td = layout.find_tile_data(t);
+    const auto p = position(t);
+    if (!td || !p)
+        return;
+
+    auto add_node = [&](const gate_or_wire& _gw)
+    {
+        flow_node node{t, _gw, heads[*p]};
+        node.po = std::holds_alternative<logic_network::vertex>(_gw) && layout.is_po(t);
+
+        std::size_t n;
+        if (!free_nodes.empty())
+        {
+            n = free_nodes.back();
+            free_nodes.pop_back();
+            nodes[n] = std::move(node);
+        }
+        else
+        {
+            n = nodes.size();
+            nodes.push_back(std::move(node));
+            stamps.push_back(0ul);
+            pending.push_back(0ul);
+        }
+
+        heads[*p] = n;
+    };
+
+    // nodes are prepended, hence, wires are added in reverse and the gate last
+    for (auto w = td->wires.crbegin(); w != td->wires.crend(); ++w)
+        add_node(w->e);
+    if (td->vertex)
+        add_node(*td->vertex);
+}
+
+void fcn_timing_view::remove_nodes(const tile& t) noexcept
+{
+    const auto p = position(t);
+    if (!p)
+        return;
+
+    for (auto n = heads[*p]; n;)
+    {
+        unlink(*n);
+
+        auto& node = nodes[*n];
+        for (auto s : node.succs)
+        {
+            auto& preds = nodes[s].preds;
+            preds.erase(std::find(preds.begin(), preds.end(), *n));
+        }
+        node.succs.clear();
+
+        node.po = false;
+        set_info(*n, {}, false);
+        node.alive = false;
+        free_nodes.push_back(*n);
+
+        n = node.next;
+    }
+
+    heads[*p] = std::nullopt;
+}
+
+void fcn_timing_view::link(const std::size_t n) noexcept
+{
+    for (const auto& [_t, _gw] : layout.incoming_data_flow(nodes[n].t, nodes[n].gw))
+    {
+        if (auto pn = find_node(_t, _gw))
+        {
+            nodes[n].preds.push_back(*pn);
+            nodes[*pn].succs.push_back(n);
+        }
+    }
+}
+
+void fcn_timing_view::unlink(const std::size_t n) noexcept
+{
+    for (auto pn : nodes[n].preds)
+    {
+        auto& succs = nodes[pn].succs;
+        succs.erase(std::find(succs.begin(), succs.end(), n));
+    }
+
+    nodes[n].preds.clear();
+}
+
+void fcn_timing_view::set_info(const std::size_t n, const path_info& info, const bool gate_diff) noexcept
+{
+    auto& node = nodes[n];
+    node.info = info;
+
+    // replace the node's contribution to the given multiset by the given value
+    auto recount = [](std::map<std::size_t, std::size_t>& _m, std::optional<std::size_t>& _counted,
+                      const std::optional<std::size_t>& _value)
+    {
+        if (_counted)
+        {
+            if (auto it = _m.find(*_counted); --it->second == 0ul)
+                _m.erase(it);
+        }
+
+        _counted = _value;
+        if (_value)
+            ++_m[*_value];
+    };
+
+    recount(diffs, node.counted_diff, gate_diff ? std::optional<std::size_t>{info.diff} : std::nullopt);
+    recount(po_lengths, node.counted_length, node.po ? std::optional<std::size_t>{info.length} : std::nullopt);
+}
+
+void fcn_timing_view::propagate(const std::vector<std::size_t>& seeds) noexcept
+{
+    // collect the fan-out cone of all seeds
+    ++stamp;
+    std::vector<std::size_t> cone{}, stack{};
+    for (auto s : seeds)
+    {
+        if (nodes[s].alive && stamps[s] != stamp)
+        {
+            stamps[s] = stamp;
+            stack.push_back(s);
+        }
+    }
+    while (!stack.empty())
+    {
+        const auto n = stack.back();
+        stack.pop_back();
+        cone.push_back(n);
+
+        for (auto s : nodes[n].succs)
+        {
+            if (stamps[s] != stamp)
+            {
+                stamps[s] = stamp;
+                stack.push_back(s);
+            }
+        }
+    }
+
+    // topological sweep through the cone; predecessors outside of it are up to date already
+    std::vector<std::size_t> ready{};
+    for (auto n : cone)
+    {
+        pending[n] = static_cast<std::size_t>(std::count_if(nodes[n].preds.cbegin(), nodes[n].preds.cend(),
+                                                            [this](const auto _p){return stamps[_p] == stamp;}));
+        if (pending[n] == 0ul)
+            ready.push_back(n);
+    }
+
+    const auto num_clocks = layout.num_clocks();
+    std::vector<path_info> infos{};
+    while (!ready.empty())
+    {
+        const auto n = ready.back();
+        ready.pop_back();
+
+        const auto& node = nodes[n];
+        const auto clock = layout.tile_clocking(node.t).value_or(0u);
+
+        if (node.preds.empty())
+            set_info(n, {1, clock, 0}, false);
+        else
+        {
+            // fetch information about all incoming paths
+            infos.clear();
+            for (auto pn : node.preds)
+                infos.push_back(nodes[pn].info);
+
+            path_info dominant_path{};
+
+            if (layout.is_pi(node.t))  // primary input in the circuit
+                infos.push_back({1, (clock + (num_clocks - 1)) % num_clocks, 0});
+
+            if (infos.size() == 1)
+                dominant_path = infos.front();
+            else  // fetch highest delay and difference
+            {
+                // sort by path length
+                std::sort(infos.begin(), infos.end(),
+                          [](const auto& i1, const auto& i2) { return i1.length < i2.length; });
+
+                dominant_path.length = infos.back().length;
+                dominant_path.delay = infos.back().delay;
+                dominant_path.diff = infos.back().delay - infos.front().delay;
+            }
+
+            // incorporate self
+            ++dominant_path.length;
+            ++dominant_path.delay;
+
+            // throughput is determined by gates only
+            set_info(n, dominant_path, std::holds_alternative<logic_network::vertex>(node.gw));
+        }
+
+        for (auto s : nodes[n].succs)
+        {
+            if (--pending[s] == 0ul)
+                ready.push_back(s);
+        }
+    }
+
+    // nodes on data flow cycles could not be reached
+    for (auto n : cone)
+    {
+        if (pending[n] != 0ul)
+            set_info(n, {}, false);
+    }
+}
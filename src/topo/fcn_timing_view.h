@@ -0,0 +1,270 @@
+//
+// fcn_timing_view.h
+//
+
+#ifndef FICTION_FCN_TIMING_VIEW_H
+#define FICTION_FCN_TIMING_VIEW_H
+
+#include "fcn_gate_layout.h"
+#include <vector>
+#include <map>
+#include <optional>
+#include <boost/container/small_vector.hpp>
+
+
+/**
+ * A timing view on an fcn_gate_layout. It computes path information (see fcn_gate_layout::path_info) for each gate and
+ * each wire segment on every tile of the layout at once and can be queried per tile afterwards.
+ *
+ * To this end, the data flow graph of the layout, i.e. all gates and wire segments connected via their incoming data
+ * flow, is extracted into dense arrays first. Path information is then propagated through it in a single topological
+ * sweep. Neither step is recursive such that arbitrarily long wires cannot overflow the stack. Each node's incoming data
+ * flow is determined exactly once.
+ *
+ * An incremental view registers itself as a tile observer of its layout and keeps track of changed tiles. Before the
+ * next query, it rebuilds the data flow graph around those tiles only and re-propagates path information through their
+ * fan-out cones. This way, each local edit costs time proportional to the affected region instead of to the layout. A
+ * non-incremental view does not observe its layout and has to be recreated after the layout has been altered. Neither
+ * kind of view supports resizing the layout.
+ *
+ * Tiles that are part of a data flow cycle, which cannot appear in valid layouts, cannot be ordered topologically and
+ * are assigned empty path information.
+ */
+class fcn_timing_view
+{
+public:
+    /**
+     * Tiles of the viewed layout.
+     */
+    using tile = fcn_gate_layout::tile;
+    /**
+     * Gate or wire on a tile.
+     */
+    using gate_or_wire = fcn_gate_layout::gate_or_wire;
+    /**
+     * Path information of a gate or wire.
+     */
+    using path_info = fcn_gate_layout::path_info;
+    /**
+     * Standard constructor. Computes path information for the whole layout. The view does not observe fgl.
+     *
+     * @param fgl Layout to view. It has to outlive the view.
+     */
+    explicit fcn_timing_view(const fcn_gate_layout& fgl) noexcept;
+    /**
+     * Standard constructor. Computes path information for the whole layout. Observing fgl requires write access to
+     * it in order to register the view as a tile observer.
+     *
+     * @param fgl Layout to view. It has to outlive the view.
+     * @param incremental Flag to indicate that the view should observe fgl and update itself on changes.
+     */
+    fcn_timing_view(fcn_gate_layout& fgl, const bool incremental) noexcept;
+    /**
+     * Copy constructor is not available.
+     */
+    fcn_timing_view(const fcn_timing_view& tv) = delete;
+    /**
+     * Move constructor is not available.
+     */
+    fcn_timing_view(fcn_timing_view&& tv) = delete;
+    /**
+     * Destructor. Unregisters the view from its layout if it is incremental.
+     */
+    ~fcn_timing_view();
+    /**
+     * Assignment operator is not available.
+     */
+    fcn_timing_view& operator=(const fcn_timing_view& rhs) = delete;
+    /**
+     * Move assignment operator is not available.
+     */
+    fcn_timing_view& operator=(fcn_timing_view&& rhs) = delete;
+    /**
+     * Returns the path information of gate or wire gw on tile t. That is the number of tiles of the longest path from
+     * a primary input to t (length), the same path length starting with the clock zone of the PI (delay), and the
+     * delay difference of the paths leading to t (diff). If gw is not assigned to t, all those values are 0.
+     *
+     * @param t Tile whose path information is desired.
+     * @param gw Gate or wire assigned to tile t.
+     * @return Path information of gw on t.
+     */
+    path_info signal_delay(const tile& t, const gate_or_wire& gw) noexcept;
+    /**
+     * Returns the path information of the gate on tile t or, if t is a wire tile, the one of its wire segment with the
+     * longest path. If t is empty, all values are 0.
+     *
+     * @param t Tile whose path information is desired.
+     * @return Path information of t.
+     */
+    path_info signal_delay(const tile& t) noexcept;
+    /**
+     * Returns the length of the longest path from any PI to any PO in tiles.
+     *
+     * @return Length of the critical path.
+     */
+    std::size_t critical_path_length() noexcept;
+    /**
+     * Returns the highest delay difference between the incoming paths of any gate in clock phases. A layout is path
+     * balanced iff this value is 0.
+     *
+     * @return Highest delay difference of all gates.
+     */
+    std::size_t max_delay_difference() noexcept;
+    /**
+     * Returns the lowest signal throughput of all gates. It is given as 1/x where only x is returned. See
+     * fcn_gate_layout::critical_path_length_and_throughput for details.
+     *
+     * @return Throughput of the layout (1/x where only x is returned).
+     */
+    std::size_t throughput() noexcept;
+    /**
+     * Incorporates all changes of the layout since the last update. Called by all queries. Does nothing for
+     * non-incremental views.
+     */
+    void update() noexcept;
+
+private:
+    /**
+     * Viewed layout.
+     */
+    const fcn_gate_layout& layout;
+    /**
+     * Layout the view is registered with as a tile observer if it is incremental.
+     */
+    fcn_gate_layout* observed = nullptr;
+    /**
+     * Identifier of the view as a tile observer of layout if it is incremental.
+     */
+    std::optional<std::size_t> observer_id{};
+    /**
+     * Node of the data flow graph, i.e. a gate or wire segment on a tile.
+     */
+    struct flow_node
+    {
+        /**
+         * Tile the node is located on.
+         */
+        tile t;
+        /**
+         * Gate or wire represented by the node.
+         */
+        gate_or_wire gw;
+        /**
+         * Next node located on the same tile.
+         */
+        std::optional<std::size_t> next{};
+        /**
+         * Nodes with data flow into this one in the order of fcn_gate_layout::incoming_data_flow.
+         */
+        boost::container::small_vector<std::size_t, 3> preds{};
+        /**
+         * Nodes this one has data flow into.
+         */
+        boost::container::small_vector<std::size_t, 3> succs{};
+        /**
+         * Computed path information.
+         */
+        path_info info{};
+        /**
+         * Delay difference and path length this node contributes to the aggregated results.
+         */
+        std::optional<std::size_t> counted_diff{}, counted_length{};
+        /**
+         * Flag to indicate that the node is a PO gate.
+         */
+        bool po = false;
+        /**
+         * Flag to indicate that the node slot is in use.
+         */
+        bool alive = true;
+    };
+    /**
+     * All nodes of the data flow graph including unused slots of removed ones.
+     */
+    std::vector<flow_node> nodes{};
+    /**
+     * Slots of removed nodes that can be reused.
+     */
+    std::vector<std::size_t> free_nodes{};
+    /**
+     * First node located on each tile addressed by the layout's tile storage position.
+     */
+    std::vector<std::optional<std::size_t>> heads{};
+    /**
+     * Multisets of the delay differences of all gates and of the path lengths of all POs, stored as value counts.
+     */
+    std::map<std::size_t, std::size_t> diffs{}, po_lengths{};
+    /**
+     * Ground tiles whose stacks have changed since the last update.
+     */
+    std::vector<tile> dirty{};
+    /**
+     * Visitation stamps of all nodes and the current stamp to avoid clearing flags between traversals.
+     */
+    std::vector<std::size_t> stamps{};
+    std::size_t stamp = 0ul;
+    /**
+     * Number of unprocessed predecessors of each node during propagation.
+     */
+    std::vector<std::size_t> pending{};
+    /**
+     * Returns the position of tile t in the layout's tile storage.
+     *
+     * @param t Tile whose position is desired.
+     * @return Storage position of t or std::nullopt if t is not covered by heads.
+     */
+    std::optional<std::size_t> position(const tile& t) const noexcept;
+    /**
+     * Returns the node representing gw on tile t.
+     *
+     * @param t Tile to look up.
+     * @param gw Gate or wire to look up.
+     * @return Index of the respective node or std::nullopt if gw is not assigned to t.
+     */
+    std::optional<std::size_t> find_node(const tile& t, const gate_or_wire& gw) const noexcept;
+    /**
+     * Re-creates heads for the current size of the layout's tile storage.
+     */
+    void rehash() noexcept;
+    /**
+     * Creates nodes for all gates and wires on tile t.
+     *
+     * @param t Tile whose assignments should be represented.
+     */
+    void create_nodes(const tile& t) noexcept;
+    /**
+     * Removes all nodes on tile t together with their data flow.
+     *
+     * @param t Tile whose nodes should be removed.
+     */
+    void remove_nodes(const tile& t) noexcept;
+    /**
+     * Determines the incoming data flow of node n anew.
+     *
+     * @param n Node whose predecessors should be determined.
+     */
+    void link(const std::size_t n) noexcept;
+    /**
+     * Removes the incoming data flow of node n.
+     *
+     * @param n Node whose predecessors should be removed.
+     */
+    void unlink(const std::size_t n) noexcept;
+    /**
+     * Sets the path information of node n and updates the aggregated results accordingly.
+     *
+     * @param n Node whose path information should be set.
+     * @param info New path information of n.
+     * @param gate_diff Flag to indicate that n's delay difference counts towards the throughput.
+     */
+    void set_info(const std::size_t n, const path_info& info, const bool gate_diff) noexcept;
+    /**
+     * Re-computes path information of the given nodes and of their whole fan-out cones in topological order.
+     *
+     * @param seeds Nodes whose path information might have changed.
+     */
+    void propagate(const std::vector<std::size_t>& seeds) noexcept;
+};
+
+
+#endif //FICTION_FCN_TIMING_VIEW_H
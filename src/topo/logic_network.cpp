@@ -533,12 +533,13 @@ void logic_network::substitute() noexcept
 
     auto decompose = [this]()
     {
+        // rewrites v_XOR in place so that it becomes the final AND of its decomposition; since no vertex is removed,
+        // all vertex descriptors, including the ones stored for PIs, POs, and constants, remain valid
         auto decompose_xor = [this](const vertex v_XOR)
         {
             auto v_FO_1  = create_logic_vertex(operation::F1O2);
             auto v_FO_2  = create_logic_vertex(operation::F1O2);
             auto v_AND_1 = create_logic_vertex(operation::AND);
-            auto v_AND_2 = create_logic_vertex(operation::AND);
             auto v_NOT   = create_logic_vertex(operation::NOT);
             auto v_OR    = create_logic_vertex(operation::OR);
 
@@ -547,8 +548,10 @@ void logic_network::substitute() noexcept
             add_edge(v_FO_2, v_AND_1);
             add_edge(v_FO_2, v_OR);
             add_edge(v_AND_1, v_NOT);
-            add_edge(v_NOT, v_AND_2);
-            add_edge(v_OR, v_AND_2);
+
+            std::vector<edge> ie{};
+            for (auto&& e : in_edges(v_XOR, true, true))
+                ie.push_back(e);
 
             auto iaop = get_inv_adjacent_vertices(v_XOR);
             auto iao = iaop.begin();
@@ -556,23 +559,32 @@ void logic_network::substitute() noexcept
             ++iao;
             add_edge(*iao, v_FO_2);
 
-            for (auto&& ao : get_adjacent_vertices(v_XOR))
-                add_edge(v_AND_2, ao);
+            for (auto& e : ie)
+                remove_edge(e);
+
+            add_edge(v_NOT, v_XOR);
+            add_edge(v_OR, v_XOR);
 
-            remove_logic_vertex(v_XOR);
+            decrement_op_counter(operation::XOR);
+            increment_op_counter(operation::AND);
+            assign_op(v_XOR, operation::AND);
         };
 
-        auto lvs = vertices();
         auto is_composed_vertex = [this](const vertex _v){return get_op(_v) == operation::XOR /* || ... */;};
 
-        auto comp_vertex = std::find_if(lvs.begin(), lvs.end(), is_composed_vertex);
-        while (comp_vertex != lvs.end())
+        // collect all composed vertices in a single pass first because decomposition appends new vertices
+        std::vector<vertex> worklist{};
+        for (auto&& v : vertices())
         {
-            if (get_op(*comp_vertex) == operation::XOR)
-                decompose_xor(*comp_vertex);
-            // else if (get_op(*comp_vertex) == operation:: ...)
+            if (is_composed_vertex(v))
+                worklist.push_back(v);
+        }
 
-            comp_vertex = std::find_if(lvs.begin(), lvs.end(), is_composed_vertex);
+        for (auto&& v : worklist)
+        {
+            if (get_op(v) == operation::XOR)
+                decompose_xor(v);
+            // else if (get_op(v) == operation:: ...)
         }
     };
 
@@ -0,0 +1,158 @@
+//
+// logic_network_csr.cpp
+//
+
+#include "logic_network_csr.h"
+#include <numeric>
+
+
+logic_network_csr::logic_network_csr(const logic_network& ln, const bool ios, const bool consts) noexcept
+        :
+        inclusion(ln.size(), false),
+        ops(ln.size(), operation::NONE),
+        pis(ln.size(), false),
+        pos(ln.size(), false),
+        out_offsets(ln.size() + 1, 0u),
+        in_offsets(ln.size() + 1, 0u)
+{
+    const auto n = ln.size();
+
+    included.reserve(ln.vertex_count(ios, consts));
+    for (auto&& v : ln.vertices(ios, consts))
+    {
+        included.push_back(v);
+        inclusion[v] = true;
+    }
+
+    for (vertex v = 0u; v < n; ++v)
+    {
+        ops[v] = ln.get_op(v);
+        pis[v] = ln.is_pi(v);
+        pos[v] = ln.is_po(v);
+    }
+
+    const auto m = ln.edge_count(ios, consts);
+    targets.reserve(m);
+    sources.reserve(m);
+    network_edges.reserve(m);
+
+    // fan-out array, edges are grouped by source in the order of logic_network::out_edges
+    for (vertex v = 0u; v < n; ++v)
+    {
+        out_offsets[v] = targets.size();
+        if (!inclusion[v])
+            continue;
+
+        for (auto&& e : ln.out_edges(v, ios, consts))
+        {
+            targets.push_back(ln.target(e));
+            sources.push_back(v);
+            network_edges.push_back(e);
+        }
+    }
+    out_offsets[n] = targets.size();
+
+    out_ids.resize(targets.size());
+    std::iota(out_ids.begin(), out_ids.end(), 0u);
+
+    // fan-in array via counting sort over targets; since edges are grouped by ascending source, incoming edges end
+    // up in ascending source order as well, which equals the order of logic_network::in_edges
+    for (auto&& t : targets)
+        ++in_offsets[t + 1];
+    std::partial_sum(in_offsets.cbegin(), in_offsets.cend(), in_offsets.begin());
+
+    in_sources.resize(targets.size());
+    in_ids.resize(targets.size());
+    std::vector<std::size_t> fill{in_offsets.cbegin(), in_offsets.cend() - 1};
+    for (edge_id e = 0u; e < targets.size(); ++e)
+    {
+        const auto slot = fill[targets[e]]++;
+        in_sources[slot] = sources[e];
+        in_ids[slot]     = e;
+    }
+}
+
+std::size_t logic_network_csr::size() const noexcept
+{
+    return ops.size();
+}
+
+std::size_t logic_network_csr::vertex_count() const noexcept
+{
+    return included.size();
+}
+
+std::size_t logic_network_csr::edge_count() const noexcept
+{
+    return targets.size();
+}
+
+logic_network_csr::vertex_range logic_network_csr::vertices() const noexcept
+{
+    return vertex_range{std::make_pair(included.cbegin(), included.cend())};
+}
+
+bool logic_network_csr::contains(const vertex v) const noexcept
+{
+    return v < inclusion.size() && inclusion[v];
+}
+
+logic_network_csr::vertex_range logic_network_csr::fan_out(const vertex v) const noexcept
+{
+    return vertex_range{std::make_pair(targets.cbegin() + out_offsets[v], targets.cbegin() + out_offsets[v + 1])};
+}
+
+logic_network_csr::vertex_range logic_network_csr::fan_in(const vertex v) const noexcept
+{
+    return vertex_range{std::make_pair(in_sources.cbegin() + in_offsets[v], in_sources.cbegin() + in_offsets[v + 1])};
+}
+
+logic_network_csr::edge_range logic_network_csr::out_edges(const vertex v) const noexcept
+{
+    return edge_range{std::make_pair(out_ids.cbegin() + out_offsets[v], out_ids.cbegin() + out_offsets[v + 1])};
+}
+
+logic_network_csr::edge_range logic_network_csr::in_edges(const vertex v) const noexcept
+{
+    return edge_range{std::make_pair(in_ids.cbegin() + in_offsets[v], in_ids.cbegin() + in_offsets[v + 1])};
+}
+
+std::size_t logic_network_csr::out_degree(const vertex v) const noexcept
+{
+    return out_offsets[v + 1] - out_offsets[v];
+}
+
+std::size_t logic_network_csr::in_degree(const vertex v) const noexcept
+{
+    return in_offsets[v + 1] - in_offsets[v];
+}
+
+logic_network_csr::vertex logic_network_csr::source(const edge_id e) const noexcept
+{
+    return sources[e];
+}
+
+logic_network_csr::vertex logic_network_csr::target(const edge_id e) const noexcept
+{
+    return targets[e];
+}
+
+logic_network::edge logic_network_csr::get_edge(const edge_id e) const noexcept
+{
+    return network_edges[e];
+}
+
+operation logic_network_csr::get_op(const vertex v) const noexcept
+{
+    return ops[v];
+}
+
+bool logic_network_csr::is_pi(const vertex v) const noexcept
+{
+    return pis[v];
+}
+
+bool logic_network_csr::is_po(const vertex v) const noexcept
+{
+    return pos[v];
+}
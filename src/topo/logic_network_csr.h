@@ -0,0 +1,225 @@
+//
+// logic_network_csr.h
+//
+
+#ifndef FICTION_LOGIC_NETWORK_CSR_H
+#define FICTION_LOGIC_NETWORK_CSR_H
+
+#include "logic_network.h"
+#include "range.h"
+#include <vector>
+
+
+/**
+ * An immutable compressed sparse row (CSR) snapshot of a logic_network. Fan-outs and fan-ins of all vertices are
+ * stored in contiguous arrays addressed via offset tables, operations in a flat array, and PI/PO flags in bitsets.
+ * Traversals over such a snapshot do not need to chase pointers through boost's setS edge containers nor to filter
+ * hidden vertices on every step. Algorithms that traverse a network multiple times should request a snapshot once and
+ * work on it instead of on the logic_network itself.
+ *
+ * Vertices keep their logic_network descriptors, i.e. vertex v of the network is vertex v of the snapshot. Vertices
+ * excluded by the ios/consts flags are still addressable but have neither fan-ins nor fan-outs and are not returned by
+ * vertices(). Edges are identified by dense indices in [0, edge_count()) which are grouped by their source vertices in
+ * the same order as returned by logic_network::out_edges.
+ *
+ * Since the snapshot does not observe its network, it has to be recreated after the network has been altered.
+ */
+class logic_network_csr
+{
+public:
+    /**
+     * Vertex type equals the one of logic_network.
+     */
+    using vertex = logic_network::vertex;
+    /**
+     * Dense index of an edge in the snapshot.
+     */
+    using edge_id = std::size_t;
+    /**
+     * Range of vertices stored contiguously.
+     */
+    using vertex_range = range_t<std::vector<vertex>::const_iterator>;
+    /**
+     * Range of edge indices stored contiguously.
+     */
+    using edge_range = range_t<std::vector<edge_id>::const_iterator>;
+    /**
+     * Standard constructor. Creates a snapshot of the given logic network.
+     *
+     * @param ln Logic network to take the snapshot of.
+     * @param ios Flag to indicate that I/O port vertices should be included.
+     * @param consts Flag to indicate that constant vertices should be included.
+     */
+    explicit logic_network_csr(const logic_network& ln, const bool ios = false, const bool consts = false) noexcept;
+    /**
+     * Returns the number of vertex slots in the snapshot. Every vertex descriptor of the snapshot is less than this
+     * value so that it can be used to size dense vertex-indexed containers.
+     *
+     * @return Number of vertex slots.
+     */
+    std::size_t size() const noexcept;
+    /**
+     * Returns the number of vertices included in the snapshot.
+     *
+     * @return Number of included vertices.
+     */
+    std::size_t vertex_count() const noexcept;
+    /**
+     * Returns the number of edges in the snapshot.
+     *
+     * @return Number of edges.
+     */
+    std::size_t edge_count() const noexcept;
+    /**
+     * Returns a range of all included vertices in ascending order.
+     *
+     * @return Range of included vertices.
+     */
+    vertex_range vertices() const noexcept;
+    /**
+     * Returns whether given vertex v is included in the snapshot.
+     *
+     * @param v Vertex to check.
+     * @return True iff v is included.
+     */
+    bool contains(const vertex v) const noexcept;
+    /**
+     * Returns a range of all successors of v.
+     *
+     * @param v Vertex whose successors are desired.
+     * @return Range of successors of v.
+     */
+    vertex_range fan_out(const vertex v) const noexcept;
+    /**
+     * Returns a range of all predecessors of v.
+     *
+     * @param v Vertex whose predecessors are desired.
+     * @return Range of predecessors of v.
+     */
+    vertex_range fan_in(const vertex v) const noexcept;
+    /**
+     * Returns a range of the indices of all outgoing edges of v.
+     *
+     * @param v Vertex whose outgoing edges are desired.
+     * @return Range of outgoing edge indices of v.
+     */
+    edge_range out_edges(const vertex v) const noexcept;
+    /**
+     * Returns a range of the indices of all incoming edges of v.
+     *
+     * @param v Vertex whose incoming edges are desired.
+     * @return Range of incoming edge indices of v.
+     */
+    edge_range in_edges(const vertex v) const noexcept;
+    /**
+     * Returns the number of successors of v.
+     *
+     * @param v Vertex whose out-degree is desired.
+     * @return Out-degree of v.
+     */
+    std::size_t out_degree(const vertex v) const noexcept;
+    /**
+     * Returns the number of predecessors of v.
+     *
+     * @param v Vertex whose in-degree is desired.
+     * @return In-degree of v.
+     */
+    std::size_t in_degree(const vertex v) const noexcept;
+    /**
+     * Returns the source vertex of the edge with index e.
+     *
+     * @param e Edge index.
+     * @return Source of e.
+     */
+    vertex source(const edge_id e) const noexcept;
+    /**
+     * Returns the target vertex of the edge with index e.
+     *
+     * @param e Edge index.
+     * @return Target of e.
+     */
+    vertex target(const edge_id e) const noexcept;
+    /**
+     * Returns the logic_network edge the edge with index e was created from.
+     *
+     * @param e Edge index.
+     * @return Edge of the original logic network.
+     */
+    logic_network::edge get_edge(const edge_id e) const noexcept;
+    /**
+     * Returns the operation assigned to vertex v.
+     *
+     * @param v Vertex whose operation is desired.
+     * @return Operation of v.
+     */
+    operation get_op(const vertex v) const noexcept;
+    /**
+     * Returns whether v is a PI port as by set entry in the original network.
+     *
+     * @param v Vertex to check.
+     * @return True iff v is a PI port.
+     */
+    bool is_pi(const vertex v) const noexcept;
+    /**
+     * Returns whether v is a PO port as by set entry in the original network.
+     *
+     * @param v Vertex to check.
+     * @return True iff v is a PO port.
+     */
+    bool is_po(const vertex v) const noexcept;
+
+private:
+    /**
+     * All included vertices in ascending order.
+     */
+    std::vector<vertex> included;
+    /**
+     * Bitset marking included vertices.
+     */
+    std::vector<bool> inclusion;
+    /**
+     * Operations of all vertex slots.
+     */
+    std::vector<operation> ops;
+    /**
+     * PI and PO bitsets.
+     */
+    std::vector<bool> pis, pos;
+    /**
+     * Fan-out offsets of size size() + 1. Since edge indices are grouped by source, the outgoing edges of v are
+     * exactly the indices in [out_offsets[v], out_offsets[v + 1]).
+     */
+    std::vector<std::size_t> out_offsets;
+    /**
+     * Fan-in offsets of size size() + 1. The incoming edges of v are stored in in_ids at the positions
+     * [in_offsets[v], in_offsets[v + 1]).
+     */
+    std::vector<std::size_t> in_offsets;
+    /**
+     * Targets of all edges indexed by edge index, i.e. the fan-out array.
+     */
+    std::vector<vertex> targets;
+    /**
+     * Sources of all edges indexed by edge index.
+     */
+    std::vector<vertex> sources;
+    /**
+     * Fan-in array holding the sources of all incoming edges grouped by target.
+     */
+    std::vector<vertex> in_sources;
+    /**
+     * Edge indices of all incoming edges grouped by target.
+     */
+    std::vector<edge_id> in_ids;
+    /**
+     * Edge indices in ascending order. Used to provide out_edges ranges.
+     */
+    std::vector<edge_id> out_ids;
+    /**
+     * Original logic_network edges indexed by edge index.
+     */
+    std::vector<logic_network::edge> network_edges;
+};
+
+
+#endif //FICTION_LOGIC_NETWORK_CSR_H
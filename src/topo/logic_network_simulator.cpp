@@ -0,0 +1,266 @@
+//
+// logic_network_simulator.cpp
+//
+
+#include "logic_network_simulator.h"
+#include <random>
+#include <stdexcept>
+
+
+logic_network_simulator::logic_network_simulator(const logic_network& ln) noexcept
+        :
+        csr{ln, true, true}
+{
+    ln.foreach_pi([this](const auto _pi){pis.push_back(_pi);});
+    ln.foreach_po([this](const auto _po){pos.push_back(_po);});
+
+    // topological order via Kahn's algorithm
+    std::vector<std::size_t> pending(csr.size(), 0ul);
+    std::vector<logic_network::vertex> ready{};
+    for (auto&& v : csr.vertices())
+    {
+        pending[v] = csr.in_degree(v);
+        if (pending[v] == 0ul)
+            ready.push_back(v);
+    }
+
+    order.reserve(csr.vertex_count());
+    while (!ready.empty())
+    {
+        const auto v = ready.back();
+        ready.pop_back();
+        order.push_back(v);
+
+        for (auto&& s : csr.fan_out(v))
+        {
+            if (--pending[s] == 0ul)
+                ready.push_back(s);
+        }
+    }
+}
+
+std::size_t logic_network_simulator::num_pis() const noexcept
+{
+    return pis.size();
+}
+
+std::size_t logic_network_simulator::num_pos() const noexcept
+{
+    return pos.size();
+}
+
+logic_network_simulator::pattern_set logic_network_simulator::simulate(const pattern_set& patterns,
+                                                                       const std::size_t num_patterns) const noexcept
+{
+    return simulate(patterns, num_patterns, {});
+}
+
+logic_network_simulator::pattern_set logic_network_simulator::simulate(const pattern_set& patterns,
+                                                                       const std::size_t num_patterns,
+                                                                       const std::vector<fault>& faults) const noexcept
+{
+    // stuck values of faulty vertices; -1 marks fault-free ones
+    std::vector<signed char> stuck(faults.empty() ? 0ul : csr.size(), -1);
+    for (auto&& f : faults)
+    {
+        if (f.v < stuck.size())
+            stuck[f.v] = f.value ? 1 : 0;
+    }
+
+    const auto num_words = words(num_patterns);
+    pattern_set results(pos.size(), bit_vector(num_words, 0ul));
+
+    // values of all vertices for the current block
+    std::vector<word> values(csr.size() * BLOCK_WORDS, 0ul);
+    const auto block = [&values](const logic_network::vertex _v){return &values[_v * BLOCK_WORDS];};
+
+    for (std::size_t offset = 0ul; offset < num_words; offset += BLOCK_WORDS)
+    {
+        const auto width = std::min(BLOCK_WORDS, num_words - offset);
+
+        for (std::size_t i = 0ul; i < pis.size(); ++i)
+        {
+            auto pi = block(pis[i]);
+            for (std::size_t w = 0ul; w < BLOCK_WORDS; ++w)
+                pi[w] = w < width ? patterns[i][offset + w] : 0ul;
+        }
+
+        for (auto&& v : order)
+        {
+            auto out = block(v);
+
+            if (!stuck.empty() && stuck[v] >= 0)
+            {
+                for (std::size_t w = 0ul; w < BLOCK_WORDS; ++w)
+                    out[w] = stuck[v] ? ~0ul : 0ul;
+
+                continue;
+            }
+
+            const auto op = csr.get_op(v);
+            if (op == operation::PI)
+                continue;
+
+            const auto fan_in = csr.fan_in(v);
+
+            if (fan_in.begin() == fan_in.end())
+            {
+                for (std::size_t w = 0ul; w < BLOCK_WORDS; ++w)
+                    out[w] = op == operation::ONE ? ~0ul : 0ul;
+
+                continue;
+            }
+
+            // fold all fan-ins with the given function starting from init
+            const auto fold = [&](const word _init, auto&& _fn)
+            {
+                for (std::size_t w = 0ul; w < BLOCK_WORDS; ++w)
+                    out[w] = _init;
+
+                for (auto&& f : fan_in)
+                {
+                    const auto in = block(f);
+                    for (std::size_t w = 0ul; w < BLOCK_WORDS; ++w)
+                        out[w] = _fn(out[w], in[w]);
+                }
+            };
+
+            switch (op)
+            {
+                case operation::AND:
+                {
+                    fold(~0ul, [](const word _a, const word _b){return _a & _b;});
+                    break;
+                }
+                case operation::OR:
+                {
+                    fold(0ul, [](const word _a, const word _b){return _a | _b;});
+                    break;
+                }
+                case operation::XOR:
+                {
+                    fold(0ul, [](const word _a, const word _b){return _a ^ _b;});
+                    break;
+                }
+                case operation::NOT:
+                {
+                    fold(0ul, [](const word, const word _b){return ~_b;});
+                    break;
+                }
+                case operation::MAJ:
+                {
+                    if (std::distance(fan_in.begin(), fan_in.end()) != 3)
+                    {
+                        fold(0ul, [](const word _a, const word){return _a;});
+                        break;
+                    }
+
+                    auto it = fan_in.begin();
+                    const auto a = block(*it), b = block(*++it), c = block(*++it);
+                    for (std::size_t w = 0ul; w < BLOCK_WORDS; ++w)
+                        out[w] = (a[w] & b[w]) | (a[w] & c[w]) | (b[w] & c[w]);
+
+                    break;
+                }
+                case operation::ONE:
+                case operation::ZERO:
+                case operation::NONE:
+                {
+                    for (std::size_t w = 0ul; w < BLOCK_WORDS; ++w)
+                        out[w] = op == operation::ONE ? ~0ul : 0ul;
+
+                    break;
+                }
+                default:  // F1O2, F1O3, W, BUF, and PO forward their input signal
+                {
+                    fold(0ul, [](const word, const word _b){return _b;});
+                    break;
+                }
+            }
+        }
+
+        for (std::size_t i = 0ul; i < pos.size(); ++i)
+        {
+            const auto po = block(pos[i]);
+            for (std::size_t w = 0ul; w < width; ++w)
+                results[i][offset + w] = po[w];
+        }
+    }
+
+    // clear bits of patterns that were not requested
+    if (const auto tail = num_patterns % 64ul; tail != 0ul)
+    {
+        for (auto& r : results)
+            r.back() &= (1ul << tail) - 1ul;
+    }
+
+    return results;
+}
+
+std::vector<bool> logic_network_simulator::simulate(const std::vector<bool>& assignment) const noexcept
+{
+    pattern_set patterns{};
+    patterns.reserve(assignment.size());
+    for (auto&& a : assignment)
+        patterns.emplace_back(1ul, a ? 1ul : 0ul);
+
+    std::vector<bool> outputs{};
+    outputs.reserve(pos.size());
+    for (auto&& r : simulate(patterns, 1ul))
+        outputs.push_back(get_bit(r, 0ul));
+
+    return outputs;
+}
+
+std::size_t logic_network_simulator::words(const std::size_t num_patterns) noexcept
+{
+    return (num_patterns + 63ul) / 64ul;
+}
+
+bool logic_network_simulator::get_bit(const bit_vector& bv, const std::size_t i) noexcept
+{
+    return (bv[i / 64ul] >> (i % 64ul)) & 1ul;
+}
+
+logic_network_simulator::pattern_set logic_network_simulator::random_patterns(const std::size_t num_inputs,
+                                                                              const std::size_t num_patterns,
+                                                                              const std::uint64_t seed) noexcept
+{
+    std::mt19937_64 rgen(seed);
+
+    pattern_set patterns(num_inputs, bit_vector(words(num_patterns), 0ul));
+    for (auto& p : patterns)
+    {
+        for (auto& w : p)
+            w = rgen();
+
+        if (const auto tail = num_patterns % 64ul; tail != 0ul)
+            p.back() &= (1ul << tail) - 1ul;
+    }
+
+    return patterns;
+}
+
+logic_network_simulator::pattern_set logic_network_simulator::exhaustive_patterns(const std::size_t num_inputs)
+{
+    if (num_inputs > MAX_EXHAUSTIVE_INPUTS)
+        throw std::invalid_argument("exhaustive simulation is limited to " + std::to_string(MAX_EXHAUSTIVE_INPUTS) +
+                                    " inputs");
+
+    // projections of the first 6 variables within a single word
+    static constexpr const word projections[] = {0xaaaaaaaaaaaaaaaaul, 0xccccccccccccccccul, 0xf0f0f0f0f0f0f0f0ul,
+                                                 0xff00ff00ff00ff00ul, 0xffff0000ffff0000ul, 0xffffffff00000000ul};
+
+    const auto num_patterns = 1ul << num_inputs;
+    pattern_set patterns(num_inputs, bit_vector(words(num_patterns), 0ul));
+    for (std::size_t i = 0ul; i < num_inputs; ++i)
+    {
+        for (std::size_t w = 0ul; w < patterns[i].size(); ++w)
+            patterns[i][w] = i < 6ul ? projections[i] : ((w >> (i - 6ul)) & 1ul ? ~0ul : 0ul);
+
+        if (const auto tail = num_patterns % 64ul; tail != 0ul)
+            patterns[i].back() &= (1ul << tail) - 1ul;
+    }
+
+    return patterns;
+}
@@ -0,0 +1,166 @@
+//
+// logic_network_simulator.h
+//
+
+#ifndef FICTION_LOGIC_NETWORK_SIMULATOR_H
+#define FICTION_LOGIC_NETWORK_SIMULATOR_H
+
+#include "logic_network.h"
+#include "logic_network_csr.h"
+#include <vector>
+#include <cstdint>
+
+
+/**
+ * A bit-parallel simulator for logic_network objects. Each vertex is evaluated on 64 input patterns at once by using
+ * one bit of a 64-bit word per pattern. Patterns are processed in blocks of BLOCK_WORDS words in fixed-length loops
+ * that the compiler can auto-vectorize. Since the build does not enable any instruction set extensions, this yields
+ * 128-bit SSE2 instructions on x86-64, i.e. two of them per block.
+ *
+ * All operations of operations.h are supported directly. That is, fan-outs, wires, and buffers simply forward their
+ * input signal so that networks extracted from fcn_gate_layout objects can be simulated without any conversion. AND,
+ * OR, and XOR are evaluated over all their fan-ins. Vertices without fan-ins as well as vertices on cycles evaluate to
+ * constant 0 except for ONE.
+ *
+ * PIs and POs are ordered by their port names like in logic_network::foreach_pi and logic_network::foreach_po. Thereby,
+ * simulation results of a network and of the one extracted from its layout can be compared position-wise.
+ *
+ * Pattern sets hold one bit vector per PI or PO in which bit i of word i / 64 represents pattern i. Pattern sets can be
+ * provided by the user or be generated randomly or exhaustively for small numbers of PIs.
+ *
+ * The simulator works on a CSR snapshot and a topological order that are both computed once on construction. Hence, it
+ * has to be recreated after the network has been altered.
+ */
+class logic_network_simulator
+{
+public:
+    /**
+     * Word holding the values of 64 patterns.
+     */
+    using word = std::uint64_t;
+    /**
+     * Values of a single signal for a number of patterns.
+     */
+    using bit_vector = std::vector<word>;
+    /**
+     * Bit vectors of all PIs or of all POs.
+     */
+    using pattern_set = std::vector<bit_vector>;
+    /**
+     * Number of words that are processed at once. 4 words equal 256 patterns.
+     */
+    static constexpr const std::size_t BLOCK_WORDS = 4ul;
+    /**
+     * Maximum number of inputs for which exhaustive pattern sets can be generated.
+     */
+    static constexpr const std::size_t MAX_EXHAUSTIVE_INPUTS = 24ul;
+    /**
+     * A stuck-at fault, i.e. a vertex whose output signal is fixed to a constant value regardless of its inputs.
+     */
+    struct fault
+    {
+        /**
+         * Faulty vertex.
+         */
+        logic_network::vertex v;
+        /**
+         * Value v is stuck at.
+         */
+        bool value;
+    };
+    /**
+     * Standard constructor. Prepares the simulation of the given logic network.
+     *
+     * @param ln Logic network to simulate.
+     */
+    explicit logic_network_simulator(const logic_network& ln) noexcept;
+    /**
+     * Returns the number of PIs of the simulated network.
+     *
+     * @return Number of PIs.
+     */
+    std::size_t num_pis() const noexcept;
+    /**
+     * Returns the number of POs of the simulated network.
+     *
+     * @return Number of POs.
+     */
+    std::size_t num_pos() const noexcept;
+    /**
+     * Simulates the given patterns. Bits of the returned bit vectors beyond num_patterns are 0.
+     *
+     * @param patterns One bit vector of at least words(num_patterns) words for each PI.
+     * @param num_patterns Number of patterns to simulate.
+     * @return One bit vector of words(num_patterns) words for each PO holding its values under all patterns.
+     */
+    pattern_set simulate(const pattern_set& patterns, const std::size_t num_patterns) const noexcept;
+    /**
+     * Simulates the given patterns in presence of the given faults. Each faulty vertex, PIs included, outputs its stuck
+     * value under all patterns. An empty fault list yields the same results as the fault-free simulation.
+     *
+     * @param patterns One bit vector of at least words(num_patterns) words for each PI.
+     * @param num_patterns Number of patterns to simulate.
+     * @param faults Faults to inject. If a vertex is listed multiple times, its last fault takes effect.
+     * @return One bit vector of words(num_patterns) words for each PO holding its values under all patterns.
+     */
+    pattern_set simulate(const pattern_set& patterns, const std::size_t num_patterns,
+                         const std::vector<fault>& faults) const noexcept;
+    /**
+     * Simulates a single input assignment.
+     *
+     * @param assignment Value of each PI.
+     * @return Value of each PO.
+     */
+    std::vector<bool> simulate(const std::vector<bool>& assignment) const noexcept;
+    /**
+     * Returns the number of words needed to hold num_patterns patterns.
+     *
+     * @param num_patterns Number of patterns.
+     * @return Number of words.
+     */
+    static std::size_t words(const std::size_t num_patterns) noexcept;
+    /**
+     * Returns the value of pattern i in bit vector bv.
+     *
+     * @param bv Bit vector to read.
+     * @param i Index of the pattern.
+     * @return Bit i of bv.
+     */
+    static bool get_bit(const bit_vector& bv, const std::size_t i) noexcept;
+    /**
+     * Generates num_patterns uniformly distributed random patterns for num_inputs inputs. The same seed always leads to
+     * the same patterns.
+     *
+     * @param num_inputs Number of inputs.
+     * @param num_patterns Number of patterns.
+     * @param seed Seed of the random number generator.
+     * @return Random pattern set.
+     */
+    static pattern_set random_patterns(const std::size_t num_inputs, const std::size_t num_patterns,
+                                       const std::uint64_t seed) noexcept;
+    /**
+     * Generates all 2^num_inputs patterns for num_inputs inputs in ascending order, i.e. input i takes value 1 in
+     * pattern p iff bit i of p is set.
+     *
+     * @param num_inputs Number of inputs. If it exceeds MAX_EXHAUSTIVE_INPUTS, an std::invalid_argument is thrown.
+     * @return Exhaustive pattern set.
+     */
+    static pattern_set exhaustive_patterns(const std::size_t num_inputs);
+
+private:
+    /**
+     * Snapshot of the simulated network including I/O ports and constants.
+     */
+    const logic_network_csr csr;
+    /**
+     * Vertices in topological order. Vertices on cycles are excluded.
+     */
+    std::vector<logic_network::vertex> order{};
+    /**
+     * PIs and POs ordered by their port names.
+     */
+    std::vector<logic_network::vertex> pis{}, pos{};
+};
+
+
+#endif //FICTION_LOGIC_NETWORK_SIMULATOR_H